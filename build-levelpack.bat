@@ -0,0 +1,45 @@
+@echo off
+setlocal
+
+set "SCRIPT_DIR=%~dp0"
+set "BUILD_DIR=%SCRIPT_DIR%build"
+set "OUTPUT=%BUILD_DIR%\levelpack.exe"
+
+echo.
+echo =============================================================================
+echo                          LEVELPACK Host Tool Build
+echo =============================================================================
+echo.
+
+if not exist "%BUILD_DIR%" mkdir "%BUILD_DIR%"
+del /Q "%OUTPUT%" 2>nul
+
+echo Compiling...
+echo.
+
+gcc -std=gnu11 -O2 -funsigned-char -Wall -Wno-unused -Wno-pointer-sign -Wno-array-bounds -Wno-int-to-pointer-cast -Wno-pointer-to-int-cast -I"%SCRIPT_DIR%tools\levelpack\host" -I"%SCRIPT_DIR%main\src\mapgen" "%SCRIPT_DIR%tools\levelpack\levelpack.c" -o "%OUTPUT%"
+set "BUILD_ERROR=%ERRORLEVEL%"
+
+echo.
+echo -----------------------------------------------------------------------------
+if %BUILD_ERROR% equ 0 (
+    if exist "%OUTPUT%" (
+        echo  Status:    OK
+        for %%A in ("%OUTPUT%") do echo  Size:      %%~zA bytes
+        echo  Output:    %OUTPUT%
+        echo  Usage:     levelpack out.d64 NAME quest-seed [-m size] [-n levels]
+        echo             levelpack out.d64 NAME -s seed,seed,... [-m size]
+        echo             levelpack -t seeds [-m size]
+    ) else (
+        echo  Status:    FAILED
+        echo  Error:     Output file not created
+        set "BUILD_ERROR=1"
+    )
+) else (
+    echo  Status:    FAILED
+    echo  Error:     Compiler error %BUILD_ERROR%
+)
+echo =============================================================================
+echo.
+pause
+exit /b %BUILD_ERROR%
@@ -0,0 +1,43 @@
+@echo off
+setlocal
+
+set "SCRIPT_DIR=%~dp0"
+set "BUILD_DIR=%SCRIPT_DIR%build"
+set "OUTPUT=%BUILD_DIR%\ovlpack.exe"
+
+echo.
+echo =============================================================================
+echo                           OVLPACK Host Tool Build
+echo =============================================================================
+echo.
+
+if not exist "%BUILD_DIR%" mkdir "%BUILD_DIR%"
+del /Q "%OUTPUT%" 2>nul
+
+echo Compiling...
+echo.
+
+gcc -std=gnu11 -O2 -Wall "%SCRIPT_DIR%tools\ovlpack\ovlpack.c" -o "%OUTPUT%"
+set "BUILD_ERROR=%ERRORLEVEL%"
+
+echo.
+echo -----------------------------------------------------------------------------
+if %BUILD_ERROR% equ 0 (
+    if exist "%OUTPUT%" (
+        echo  Status:    OK
+        for %%A in ("%OUTPUT%") do echo  Size:      %%~zA bytes
+        echo  Output:    %OUTPUT%
+        echo  Usage:     ovlpack in.prg out.lz
+    ) else (
+        echo  Status:    FAILED
+        echo  Error:     Output file not created
+        set "BUILD_ERROR=1"
+    )
+) else (
+    echo  Status:    FAILED
+    echo  Error:     Compiler error %BUILD_ERROR%
+)
+echo =============================================================================
+echo.
+pause
+exit /b %BUILD_ERROR%
@@ -7,6 +7,7 @@
 // Project headers (API and configuration)
 #include "mapgen/mapgen_api.h"
 #include "mapgen/mapgen_config.h"
+#include "mapgen/mapgen_overlay.h"
 
 #ifdef DEBUG_MAPGEN
 // DEBUG mode additional headers
@@ -15,6 +16,22 @@
 #include "mapgen/mapgen_debug.h"
 #endif
 
+#ifdef MAPGEN_OVERLAY
+// =============================================================================
+// Overlay Build Memory Layout (see mapgen_overlay.h)
+// =============================================================================
+// Resident code and all data below the overlay; generator code in the
+// "MAPGEN" overlay file. Modules switch to mgcode around generator code.
+
+#pragma overlay(mapgen, 1)
+
+#pragma region(main, 0x0a00, MAPGEN_OVERLAY_BASE, , , {code, data, bss, heap, stack})
+
+#pragma section(mgjump, 0)
+#pragma section(mgcode, 0)
+#pragma region(mapgen, MAPGEN_OVERLAY_BASE, MAPGEN_OVERLAY_END, , 1, {mgjump, mgcode})
+#endif
+
 // =============================================================================
 // OSCAR64 Module Includes (single-file compilation model)
 // =============================================================================
@@ -24,13 +41,43 @@
 #include "mapgen/tmea_data.c"         // TMEA lookup tables (items, monsters)
 #include "mapgen/mapgen_config.c"     // Configuration and parameter management
 #include "mapgen/mapgen_utils.c"      // Utility functions and tile operations
+
+#ifdef MAPGEN_OVERLAY
+#include "mapgen/mapgen_overlay.c"    // Overlay header and resident stubs
+#pragma code(mgcode)
+#endif
 #include "mapgen/map_generation.c"    // Generation pipeline controller
+#ifdef MAPGEN_OVERLAY
+#pragma code(mgcode)
+#endif
 #include "mapgen/room_management.c"   // Room placement algorithms
 #include "mapgen/connection_system.c" // Corridor and feature generation
+#ifdef MAPGEN_OVERLAY
+#pragma code(code)
+#endif
+
+// Game runtime modules - exploration and gameplay support on generated maps
+#include "mapgen/fog_of_war.c"        // Explored tile bitplane
+#include "mapgen/region_map.c"        // Room/corridor membership layer
+#include "mapgen/field_of_view.c"     // Shadowcasting visibility
+#include "mapgen/flow_field.c"        // Monster pursuit distance field
+#include "mapgen/room_path.c"         // Room graph pathfinding
+#include "mapgen/turn_scheduler.c"    // Actor turn order
+#include "mapgen/status_effects.c"    // Status effect timers
+#include "mapgen/combat_tables.c"     // Precomputed combat outcomes
+#include "mapgen/spawn_tables.c"      // Weighted loot/monster spawning
+#include "mapgen/level_journal.c"     // Per-level state deltas
+#include "mapgen/lz_codec.c"          // LZ compression for level data
+#include "mapgen/level_cache.c"       // Compressed level cache under ROM
+#include "mapgen/game_save.c"         // Block-transfer game save/load
+#include "mapgen/level_pack.c"        // Pre-generated level streaming
+#include "mapgen/dungeon_set.c"       // Quest level planning, lined-up stairs
+#include "mapgen/overlay_loader.c"    // Packed overlay streaming
 
 #ifdef DEBUG_MAPGEN
 // DEBUG mode modules - display, export, progress bar, interactive menu
 #include "mapgen/mapgen_progress.c"   // Progress bar system
+#include "mapgen/mapgen_bench.c"      // On-target benchmarks
 #include "mapgen/mapgen_display.c"    // Viewport rendering
 #include "mapgen/map_export.c"        // File I/O
 #include "mapgen/mapgen_debug.c"      // Interactive debug mode
@@ -61,6 +108,9 @@ int main(void) {
 #else
     // RELEASE MODE: Generate a default map to verify API works
     // This also ensures the mapgen code is not optimized away
+#ifdef MAPGEN_OVERLAY
+    if (!mapgen_overlay_load()) return 1;
+#endif
     mapgen_init(12345);
     mapgen_generate_with_params(
         1,  // MEDIUM map (64x64, 16 rooms)
@@ -72,6 +122,12 @@ int main(void) {
     // - compact_map[] : 3-bit packed tile data
     // - room_list[]   : Room structures with metadata
     // - room_count    : Number of rooms generated
+    // Game runtime state (fog, turn queue, combat tables) for the new level
+    level_enter(1);
+#ifdef MAPGEN_OVERLAY
+    // Generator code is no longer needed; its RAM belongs to the game
+    mapgen_overlay_release();
+#endif
 #endif
 
     return 0;
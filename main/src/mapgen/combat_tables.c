@@ -0,0 +1,254 @@
+// =============================================================================
+// COMBAT TABLES - Precomputed Per-Monster-Type Attack Outcomes
+// Implementation - Oscar64 Optimized
+// =============================================================================
+
+#include "combat_tables.h"
+#include "status_effects.h"
+#include "tmea_core.h"
+#include "tmea_data.h"
+#include "tmea_types.h"
+#include "mapgen_utils.h"
+
+// =============================================================================
+// GLOBAL STATE DEFINITIONS
+// =============================================================================
+
+CombatLoadout combat_loadout = {
+    ITEM_NONE, 0, ITEM_NONE, 0, ITEM_NONE, 0, 10, 10
+};
+
+unsigned char combat_hit_thr[MON_TYPE_COUNT];               // 11 bytes
+unsigned char combat_crit_thr[MON_TYPE_COUNT];              // 11 bytes
+unsigned char combat_dmg[MON_TYPE_COUNT];                   // 11 bytes
+unsigned char combat_crit_dmg[MON_TYPE_COUNT];              // 11 bytes
+unsigned char combat_mon_dmg[MON_TYPE_COUNT];               // 11 bytes
+unsigned char combat_fx[MON_TYPE_COUNT];                    // 11 bytes
+
+unsigned char combat_player_ac;                             // 1 byte
+unsigned char combat_block_thr;                             // 1 byte
+
+unsigned char combat_damage_out;                            // 1 byte
+unsigned char combat_fx_out;                                // 1 byte
+
+static unsigned char combat_mon_fx[MON_TYPE_COUNT];         // 11 bytes - monster procs
+static unsigned char combat_sleep_crit_thr;                 // Crit vs sleeping target
+static unsigned char combat_var_dmg, combat_var_crit_dmg;   // MFLAG_UNDEAD_VAR targets
+static unsigned char combat_bash;                           // Shield can bash
+static unsigned int combat_status_seen;                     // Status bits tables were built for
+
+// =============================================================================
+// CONSTANTS
+// =============================================================================
+
+#define COMBAT_SLEEP_THR        243     // 95% auto-hit on sleeping targets
+#define COMBAT_POISON_THR       77      // 30% poison proc
+#define COMBAT_STUN_THR         38      // 15% stun proc
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+// Percentage (0-100+) to rnd_byte() threshold
+static unsigned char combat_pct_to_thr(unsigned char pct) {
+    unsigned int thr = ((unsigned int)pct * 256 + 50) / 100;
+    return (thr > 255) ? 255 : (unsigned char)thr;
+}
+
+static unsigned char combat_clamp_pct(int pct) {
+    if (pct > 95) return 95;
+    if (pct < 5) return 5;
+    return (unsigned char)pct;
+}
+
+// Final player damage: crit doubles, berserk adds 50%, minimum 1
+static unsigned char combat_final_damage(unsigned char damage, unsigned char crit) {
+    unsigned int d = damage;
+    if (crit) d <<= 1;
+    if (status_active & STATUS_BERSERK) d += d >> 1;
+    if (d < 1) d = 1;
+    return (d > 255) ? 255 : (unsigned char)d;
+}
+
+static unsigned char combat_modifier(unsigned char data) {
+    unsigned char mod = ITEM_GET_MODIFIER(data);
+    return (mod >= 1 && mod <= 3) ? mod : 0;
+}
+
+// =============================================================================
+// TABLE FUNCTIONS
+// =============================================================================
+
+void combat_rebuild(void) {
+    const CombatLoadout *lo = &combat_loadout;
+    const WeaponDef *weapon = get_weapon_def(lo->weapon_type);
+    const ArmorDef *armor = get_armor_def(lo->armor_type);
+    const ShieldDef *shield = get_shield_def(lo->shield_type);
+
+    unsigned char w_damage = 1, w_hit = 0, w_crit = 0, w_special = 0;
+    if (weapon) {
+        w_damage = weapon->damage;
+        w_hit = weapon->hit_bonus;
+        w_crit = weapon->crit_chance;
+        w_special = weapon->special;
+    }
+    if (w_special & WEAPON_SPECIAL_TWO_HANDED) shield = (const ShieldDef *)0;
+
+    // Player damage before target bonuses (6.2)
+    unsigned char base = w_damage + combat_modifier(lo->weapon_data);
+    if (lo->str > 10) base += (lo->str - 10) >> 1;
+
+    // Target-independent part of hit chance (6.1)
+    int hit_common = 70 + w_hit * 5 + ((int)lo->dex - 10) * 2;
+    if (status_active & STATUS_BLIND) hit_common -= 20;
+    if (status_active & STATUS_HASTE) hit_common += 10;
+    if (status_active & STATUS_BLESSED) hit_common += 10;
+
+    unsigned char crit_pct = 5 + w_crit;
+    combat_sleep_crit_thr = ((unsigned int)COMBAT_SLEEP_THR * crit_pct + 50) / 100;
+
+    // Weapon procs shared by all targets
+    unsigned char weapon_fx = 0;
+    if (w_special & WEAPON_SPECIAL_POISON) weapon_fx |= COMBAT_FX_POISON;
+    if (w_special & WEAPON_SPECIAL_STUN) weapon_fx |= COMBAT_FX_STUN;
+    if (w_special & WEAPON_SPECIAL_LIFE_DRAIN) weapon_fx |= COMBAT_FX_LIFE_DRAIN;
+    if (w_special & WEAPON_SPECIAL_CLEAVE) weapon_fx |= COMBAT_FX_CLEAVE;
+
+    // Player AC (6.3)
+    unsigned char ac = 10 + combat_modifier(lo->armor_data);
+    if (armor) ac += armor->armor_class;
+    if (shield) ac += shield->defense;
+    if (lo->dex > 10) {
+        unsigned char dex_bonus = (lo->dex - 10) >> 1;
+        ac += (dex_bonus > 5) ? 5 : dex_bonus;
+    }
+    if (status_active & STATUS_SHIELD_BUFF) ac += 3;
+    if (status_active & STATUS_BERSERK) ac -= ac / 5;
+    combat_player_ac = ac;
+
+    // Shield block (6.4)
+    combat_block_thr = 0;
+    combat_bash = 0;
+    if (shield) {
+        unsigned char block = shield->block_chance + combat_modifier(lo->shield_data) * 5;
+        if (lo->dex > 12) block += lo->dex - 12;
+        combat_block_thr = combat_pct_to_thr(block);
+        combat_bash = (shield->special & SHIELD_SPECIAL_BASH) != 0;
+    }
+
+    // Undead variants (MFLAG_UNDEAD_VAR) of non-undead types
+    combat_var_dmg = 0;
+    combat_var_crit_dmg = 0;
+    if (w_special & WEAPON_SPECIAL_VS_UNDEAD) {
+        combat_var_dmg = combat_final_damage(base + 3, 0);
+        combat_var_crit_dmg = combat_final_damage(base + 3, 1);
+    }
+
+    unsigned char poison_ok = !(armor && (armor->special & ARMOR_SPECIAL_POISON_IMMUNE));
+
+    for (unsigned char t = 0; t < MON_TYPE_COUNT; t++) {
+        const MonsterDef *mdef = &monster_table[t];
+
+        // Pierce armor ignores half of the AC penalty
+        unsigned char ac_penalty = (w_special & WEAPON_SPECIAL_PIERCE_ARMOR)
+                                 ? mdef->armor_class : mdef->armor_class * 2;
+        unsigned char hit_pct = combat_clamp_pct(hit_common - mdef->defense * 3 - ac_penalty);
+        unsigned char hit_thr = combat_pct_to_thr(hit_pct);
+        combat_hit_thr[t] = hit_thr;
+        combat_crit_thr[t] = ((unsigned int)hit_thr * crit_pct + 50) / 100;
+
+        unsigned char bonus = 0;
+        unsigned char fx = weapon_fx;
+        if ((w_special & WEAPON_SPECIAL_VS_UNDEAD) && (mdef->def_flags & MDEF_UNDEAD)) {
+            bonus += 3;
+            fx |= COMBAT_FX_BONUS;
+        }
+        if ((w_special & WEAPON_SPECIAL_VS_DEMON) && (mdef->def_flags & MDEF_DEMON)) {
+            bonus += 3;
+            fx |= COMBAT_FX_BONUS;
+        }
+        combat_fx[t] = fx;
+        combat_dmg[t] = combat_final_damage(base + bonus, 0);
+        combat_crit_dmg[t] = combat_final_damage(base + bonus, 1);
+
+        // Monster damage: AC / 2 absorbed, minimum 1 (6.9)
+        unsigned char half_ac = ac >> 1;
+        combat_mon_dmg[t] = (mdef->damage > half_ac) ? mdef->damage - half_ac : 1;
+
+        unsigned char mfx = 0;
+        if (mdef->def_flags & MDEF_LIFE_DRAIN) mfx |= COMBAT_FX_LIFE_DRAIN;
+        if ((mdef->def_flags & MDEF_POISON_ATK) && poison_ok) mfx |= COMBAT_FX_POISON;
+        combat_mon_fx[t] = mfx;
+    }
+
+    combat_status_seen = status_active & COMBAT_STATUS_MASK;
+}
+
+void combat_refresh(void) {
+    if ((status_active & COMBAT_STATUS_MASK) != combat_status_seen) {
+        combat_rebuild();
+    }
+}
+
+// =============================================================================
+// ATTACK FUNCTIONS
+// =============================================================================
+
+unsigned char combat_player_attack(const TinyMon *mon) {
+    unsigned char t = mon->type;
+    unsigned char roll = rnd_byte();
+    unsigned char hit_thr = combat_hit_thr[t];
+    unsigned char crit_thr = combat_crit_thr[t];
+    unsigned char fx = combat_fx[t];
+    unsigned char dmg = combat_dmg[t];
+    unsigned char crit_dmg = combat_crit_dmg[t];
+
+    if (mon->flags & MFLAG_SLEEPING) {
+        hit_thr = COMBAT_SLEEP_THR;
+        crit_thr = combat_sleep_crit_thr;
+    }
+    if ((mon->flags & MFLAG_UNDEAD_VAR) && combat_var_dmg && !(fx & COMBAT_FX_BONUS)) {
+        dmg = combat_var_dmg;
+        crit_dmg = combat_var_crit_dmg;
+        fx |= COMBAT_FX_BONUS;
+    }
+
+    combat_damage_out = 0;
+    combat_fx_out = 0;
+    if (roll >= hit_thr) return COMBAT_MISS;
+
+    unsigned char result = (roll < crit_thr) ? COMBAT_CRIT : COMBAT_HIT;
+    combat_damage_out = (result == COMBAT_CRIT) ? crit_dmg : dmg;
+    combat_fx_out = fx & (COMBAT_FX_BONUS | COMBAT_FX_LIFE_DRAIN | COMBAT_FX_CLEAVE);
+
+    if (fx & (COMBAT_FX_POISON | COMBAT_FX_STUN)) {
+        unsigned char proc = rnd_byte();
+        if ((fx & COMBAT_FX_POISON) && proc < COMBAT_POISON_THR) combat_fx_out |= COMBAT_FX_POISON;
+        if ((fx & COMBAT_FX_STUN) && proc < COMBAT_STUN_THR) combat_fx_out |= COMBAT_FX_STUN;
+    }
+    return result;
+}
+
+unsigned char combat_monster_attack(const TinyMon *mon) {
+    unsigned char t = mon->type;
+    unsigned char roll = rnd_byte();
+
+    combat_fx_out = 0;
+    if (roll < combat_block_thr) {
+        // Bash: 1 damage back to the attacker, which is stunned
+        combat_damage_out = combat_bash;
+        if (combat_bash) {
+            combat_fx_out = COMBAT_FX_STUN;
+            return COMBAT_BASH;
+        }
+        return COMBAT_BLOCK;
+    }
+
+    combat_damage_out = combat_mon_dmg[t];
+    unsigned char mfx = combat_mon_fx[t];
+    combat_fx_out = mfx & COMBAT_FX_LIFE_DRAIN;
+    if ((mfx & COMBAT_FX_POISON) && rnd_byte() < COMBAT_POISON_THR) {
+        combat_fx_out |= COMBAT_FX_POISON;
+    }
+    return COMBAT_HIT;
+}
@@ -0,0 +1,122 @@
+#ifndef COMBAT_TABLES_H
+#define COMBAT_TABLES_H
+
+// =============================================================================
+// COMBAT TABLES - Precomputed Per-Monster-Type Attack Outcomes
+// =============================================================================
+//
+// The combat formulas (game-architecture-plan.md 6.1-6.4) combine weapon,
+// armour, shield, stats, status and monster definition with percentage
+// multiplies and divides. All of that depends only on the player loadout,
+// the active status flags and the monster type, so it is folded into small
+// tables once and each attack becomes one rnd_byte() plus lookups.
+//
+// Rebuild triggers:
+// - Equipment or stat change:  combat_rebuild()
+// - Level load:                automatic (level_enter)
+// - Status change:             combat_refresh() once per turn rebuilds only
+//                              if a combat-relevant STATUS_* bit changed
+//
+// Thresholds are chances scaled to 0-256: an event happens if
+// rnd_byte() < threshold.
+// - Player attack: roll < crit threshold -> crit, < hit threshold -> hit
+//   (crit threshold = hit chance * crit chance, one roll for both)
+// - Monster attack: roll < block threshold -> blocked (bash if shield has
+//   SHIELD_SPECIAL_BASH), otherwise precomputed damage after player AC
+//
+// Performance: rebuild ~6000 cycles, attack ~80 cycles
+// Memory: 6 x 11 bytes tables + 16 bytes loadout/scalars
+//
+// =============================================================================
+
+#include "tmea_types.h"
+
+// Attack results
+#define COMBAT_MISS     0
+#define COMBAT_HIT      1
+#define COMBAT_CRIT     2
+#define COMBAT_BLOCK    3       // Monster attack stopped by shield
+#define COMBAT_BASH     4       // Blocked + shield bash counter
+
+// Side-effect flags (combat_fx[] and combat_fx_out)
+#define COMBAT_FX_BONUS         0x01    // VS_UNDEAD / VS_DEMON bonus applies
+#define COMBAT_FX_POISON        0x02    // Poison proc
+#define COMBAT_FX_STUN          0x04    // Stun proc
+#define COMBAT_FX_LIFE_DRAIN    0x08    // Attacker heals from damage
+#define COMBAT_FX_CLEAVE        0x10    // Splash damage to adjacent enemy
+
+// STATUS_* bits that change the tables
+#define COMBAT_STATUS_MASK (STATUS_HASTE | STATUS_SHIELD_BUFF | STATUS_BERSERK | \
+                            STATUS_BLESSED | STATUS_BLIND)
+
+// Player equipment and stats (8 bytes)
+typedef struct {
+    unsigned char weapon_type;  // Weapon subtype 0-7 or ITEM_NONE (bare hands)
+    unsigned char weapon_data;  // ITEM_MOD_* modifier byte
+    unsigned char armor_type;   // Armor subtype 0-7 or ITEM_NONE
+    unsigned char armor_data;
+    unsigned char shield_type;  // Shield subtype 0-4 or ITEM_NONE
+    unsigned char shield_data;
+    unsigned char str;          // Strength (10 = average)
+    unsigned char dex;          // Dexterity (10 = average)
+} CombatLoadout;
+
+// =============================================================================
+// GLOBAL STATE DECLARATIONS
+// =============================================================================
+
+extern CombatLoadout combat_loadout;                        // Edit, then combat_rebuild()
+
+extern unsigned char combat_hit_thr[MON_TYPE_COUNT];        // Player hits monster
+extern unsigned char combat_crit_thr[MON_TYPE_COUNT];       // Player crits monster
+extern unsigned char combat_dmg[MON_TYPE_COUNT];            // Player damage
+extern unsigned char combat_crit_dmg[MON_TYPE_COUNT];       // Player crit damage
+extern unsigned char combat_mon_dmg[MON_TYPE_COUNT];        // Monster damage after AC
+extern unsigned char combat_fx[MON_TYPE_COUNT];             // COMBAT_FX_* per type
+
+extern unsigned char combat_player_ac;                      // For display
+extern unsigned char combat_block_thr;                      // 0 = no block possible
+
+extern unsigned char combat_damage_out;                     // Damage of last attack
+extern unsigned char combat_fx_out;                         // COMBAT_FX_* of last attack
+
+// =============================================================================
+// TABLE FUNCTIONS
+// =============================================================================
+
+/**
+ * @brief Recompute all tables from combat_loadout and status_active
+ */
+void combat_rebuild(void);
+
+/**
+ * @brief Rebuild only if combat-relevant status flags changed
+ *
+ * Call once per turn after status_update(); usually a single compare.
+ */
+void combat_refresh(void);
+
+// =============================================================================
+// ATTACK FUNCTIONS
+// =============================================================================
+
+/**
+ * @brief Resolve a player attack
+ * @param mon Target monster
+ * @return COMBAT_MISS, COMBAT_HIT or COMBAT_CRIT
+ *
+ * Sets combat_damage_out and combat_fx_out (procs rolled with a second
+ * byte only if the weapon has poison/stun). Caller applies the damage.
+ */
+unsigned char combat_player_attack(const TinyMon *mon);
+
+/**
+ * @brief Resolve a monster attack on the player
+ * @param mon Attacking monster
+ * @return COMBAT_HIT, COMBAT_BLOCK or COMBAT_BASH
+ *
+ * Sets combat_damage_out and combat_fx_out (life drain, poison proc).
+ */
+unsigned char combat_monster_attack(const TinyMon *mon);
+
+#endif // COMBAT_TABLES_H
@@ -8,16 +8,11 @@
 #include "mapgen_utils.h"
 #include "mapgen_progress.h" // For progress bar functions (DEBUG only)
 #include "tmea_core.h"       // For add_secret_door_metadata() and TMEA functions
+#include "region_map.h"      // For corridor region recording
 
 // External reference to current generation parameters
 extern MapParameters current_params;
 
-typedef struct {
-    unsigned char count;
-    unsigned char x[2];
-    unsigned char y[2];
-} CorridorBreakpoints;
-
 // =============================================================================
 // HELPER FUNCTIONS
 // =============================================================================
@@ -74,10 +69,15 @@ static unsigned char determine_corridor_type(unsigned char start_x, unsigned cha
     return 2;
 }
 
-static void compute_corridor_breakpoints(unsigned char start_x, unsigned char start_y,
-                                         unsigned char end_x, unsigned char end_y,
-                                         unsigned char wall_side, unsigned char corridor_type,
-                                         CorridorBreakpoints *out) {
+// Resident in the overlay build: room_path uses it at game time
+#ifdef MAPGEN_OVERLAY
+#pragma code(code)
+#endif
+
+void compute_corridor_breakpoints(unsigned char start_x, unsigned char start_y,
+                                  unsigned char end_x, unsigned char end_y,
+                                  unsigned char wall_side, unsigned char corridor_type,
+                                  CorridorBreakpoints *out) {
     out->count = 0;
     out->x[0] = 255; out->y[0] = 255;
     out->x[1] = 255; out->y[1] = 255;
@@ -123,6 +123,10 @@ static void compute_corridor_breakpoints(unsigned char start_x, unsigned char st
     }
 }
 
+#ifdef MAPGEN_OVERLAY
+#pragma code(mgcode)
+#endif
+
 
 // =============================================================================
 // CORRIDOR DRAWING FUNCTIONS (RESTORED WORKING ORIGINALS)
@@ -186,8 +190,9 @@ static unsigned char process_corridor_path(unsigned char start_x, unsigned char
             return 0;
         }
 
-        // Segment-based walling (DRAW mode only)
+        // Segment-based walling and region recording (DRAW mode only)
         if (mode == CORRIDOR_MODE_DRAW) {
+            region_add_segment(current_x, current_y, next_x, next_y);
             place_wall_straight_corridor(current_x, current_y, next_x, next_y);
             place_wall_corridor_junction(next_x, next_y);  // Fill diagonal corners at breakpoint
         }
@@ -200,8 +205,9 @@ static unsigned char process_corridor_path(unsigned char start_x, unsigned char
         return 0;
     }
 
-    // Final segment walling
+    // Final segment walling and region recording
     if (mode == CORRIDOR_MODE_DRAW) {
+        region_add_segment(current_x, current_y, end_x, end_y);
         place_wall_straight_corridor(current_x, current_y, end_x, end_y);
     }
 
@@ -420,6 +426,7 @@ unsigned char connect_rooms(unsigned char room1, unsigned char room2, unsigned c
     unsigned char wall1 = get_wall_side_from_exit(room1, exit1_x, exit1_y);
     unsigned char wall2 = get_wall_side_from_exit(room2, exit2_x, exit2_y);
 
+    region_begin_corridor(room1, room2);
     draw_corridor_from_door(exit1_x, exit1_y, wall1, exit2_x, exit2_y, corridor_type, is_secret);
 
     // Place doors (always TILE_DOOR, metadata marks secret doors)
@@ -460,42 +467,95 @@ unsigned char connect_rooms(unsigned char room1, unsigned char room2, unsigned c
 // MST CONNECTION ALGORITHM
 // =============================================================================
 
-// Connect all rooms using Minimum Spanning Tree algorithm
+// Rooms in the 8 placement cells around a room's cell (at most 8)
+static unsigned char grid_neighbours(unsigned char room, unsigned char *out) {
+    const unsigned char gs = current_params.grid_size;
+    const unsigned char cell = room_grid_cell[room];
+    const unsigned char gx = get_grid_x(cell, gs);
+    const unsigned char gy = get_grid_y(cell, gs);
+    unsigned char n = 0;
+
+    for (unsigned char ny = gy ? gy - 1 : 0; ny <= gy + 1 && ny < gs; ny++) {
+        for (unsigned char nx = gx ? gx - 1 : 0; nx <= gx + 1 && nx < gs; nx++) {
+            unsigned char r = grid_room[ny * gs + nx];
+            if (r != 255 && r != room) out[n++] = r;
+        }
+    }
+    return n;
+}
+
+// Connect all rooms using Minimum Spanning Tree algorithm (Prim)
+//
+// Edge candidates come from the placement grid: a room only considers
+// rooms in adjacent and diagonal cells. Each joining room relaxes its
+// <= 8 neighbours and the next room is the cheapest candidate (one pass
+// over best_dist[]), so a step costs O(n) instead of O(n^2).
 void build_room_network(void) {
     static unsigned char connected[MAX_ROOMS];
+    static unsigned char best_dist[MAX_ROOMS];   // Shortest candidate edge into the tree
+    static unsigned char best_from[MAX_ROOMS];   // Tree room at its other end
+    unsigned char near[8];
 
     // Initialize - only first room is connected
     for (unsigned char i = 0; i < room_count; i++) {
         connected[i] = (i == 0) ? 1 : 0;
+        best_dist[i] = 255;
     }
 
     unsigned char connections_made = 0;
+    unsigned char joined = 0;
+    unsigned char failures = 0;
 
     // MST algorithm - connect closest unconnected rooms
     while (connections_made < room_count - 1) {
-        unsigned char best_room1 = 255, best_room2 = 255;
+        // Relax the grid neighbours of the room that joined last
+        unsigned char n = (joined != 255) ? grid_neighbours(joined, near) : 0;
+        for (unsigned char k = 0; k < n; k++) {
+            unsigned char j = near[k];
+            if (connected[j]) continue;
+
+            unsigned char distance = calculate_room_distance(joined, j);
+            if (distance < best_dist[j]) {
+                best_dist[j] = distance;
+                best_from[j] = joined;
+            }
+        }
+
+        // Cheapest candidate
+        unsigned char best_room = 255;
         unsigned char min_distance = 255;
+        for (unsigned char j = 0; j < room_count; j++) {
+            if (!connected[j] && best_dist[j] < min_distance) {
+                min_distance = best_dist[j];
+                best_room = j;
+            }
+        }
 
-        // Find closest unconnected room pair
-        for (unsigned char i = 0; i < room_count; i++) {
-            if (!connected[i]) continue;
-
-            for (unsigned char j = 0; j < room_count; j++) {
-                if (connected[j] || i == j) continue;
-                
-                unsigned char distance = calculate_room_distance(i, j);
-                if (distance < min_distance) {
-                    min_distance = distance;
-                    best_room1 = i;
-                    best_room2 = j;
+        // Empty cells can cut the grid in two: then fall back to the
+        // closest room pair overall for this one step
+        if (best_room == 255) {
+            mapgen_stats.mst_fallbacks++;
+            for (unsigned char i = 0; i < room_count; i++) {
+                if (!connected[i]) continue;
+
+                for (unsigned char j = 0; j < room_count; j++) {
+                    if (connected[j]) continue;
+
+                    unsigned char distance = calculate_room_distance(i, j);
+                    if (distance < min_distance) {
+                        min_distance = distance;
+                        best_room = j;
+                        best_from[j] = i;
+                    }
                 }
             }
         }
-        
+
         // Connect the best pair
-        if (best_room1 != 255) {
-            if (connect_rooms(best_room1, best_room2, 0)) {
-                connected[best_room2] = 1;
+        if (best_room != 255) {
+            if (connect_rooms(best_from[best_room], best_room, 0)) {
+                connected[best_room] = 1;
+                joined = best_room;
                 connections_made++;
                 total_connections++; // Runtime tracking for percentage calculation
 #ifdef DEBUG_MAPGEN
@@ -505,12 +565,18 @@ void build_room_network(void) {
                 }
 #endif
             } else {
-                break;
+                // Corridor blocked: drop this candidate, try the next best
+                best_dist[best_room] = 255;
+                joined = 255;
+                mapgen_stats.connect_failures++;
+                if (++failures > room_count) break;
             }
         } else {
             break;
         }
     }
+
+    mapgen_stats.rooms_unjoined = room_count ? room_count - 1 - connections_made : 0;
 }
 
 // =============================================================================
@@ -569,18 +635,21 @@ static unsigned char create_hidden_room(unsigned char room_idx) {
 
     // Reuse is_non_branching_corridor logic - check if the connection is non-branching
     if (!is_non_branching_corridor(room_idx, connected_room)) {
+        mapgen_stats.hidden_rejects++;
         return 0; // Connection is branching or invalid
     }
 
     // Get the connected room's door position for this connection
     unsigned char connected_door_x, connected_door_y, connected_wall_side, temp_corridor_type;
     if (!get_connection_info(connected_room, room_idx, &connected_door_x, &connected_door_y, &connected_wall_side, &temp_corridor_type)) {
+        mapgen_stats.hidden_rejects++;
         return 0; // Connection not found
     }
 
     // OPTIMIZED: Instant O(1) wall door count check
     // If more than 1 door on this wall, skip (would delete existing corridor)
     if (room_list[connected_room].wall_door_count[connected_wall_side] > 1) {
+        mapgen_stats.hidden_rejects++;
         return 0;
     }
 
@@ -652,14 +721,17 @@ static unsigned char create_hidden_passage(unsigned char room1, unsigned char ro
 void place_hidden_passages(unsigned char passage_count) {
     if (room_count < 2 || passage_count == 0) return;
 
-    // Collect eligible corridor candidates
-    static unsigned char cand_r1[40];
-    static unsigned char cand_r2[40];
+    // Collect eligible corridor candidates - walk each room's connection
+    // list (O(connections)) instead of testing all room pairs
+    static unsigned char cand_r1[MAX_CONNECTIONS];
+    static unsigned char cand_r2[MAX_CONNECTIONS];
     unsigned char cand_count = 0;
 
-    for (unsigned char i = 0; i < room_count && cand_count < 40; i++) {
-        for (unsigned char j = i + 1; j < room_count && cand_count < 40; j++) {
-            if (room_has_connection_to(i, j) && is_non_branching_corridor(i, j)) {
+    for (unsigned char i = 0; i < room_count; i++) {
+        Room *room = &room_list[i];
+        for (unsigned char c = 0; c < room->connections && cand_count < MAX_CONNECTIONS; c++) {
+            unsigned char j = room->conn_data[c].room_id;
+            if (j > i && is_non_branching_corridor(i, j)) {
                 cand_r1[cand_count] = i;
                 cand_r2[cand_count] = j;
                 cand_count++;
@@ -667,6 +739,7 @@ void place_hidden_passages(unsigned char passage_count) {
         }
     }
 
+    mapgen_stats.passage_candidates = cand_count;
     if (cand_count == 0) {
 #ifdef DEBUG_MAPGEN
         update_progress_step(5, 0, passage_count);
@@ -685,6 +758,8 @@ void place_hidden_passages(unsigned char passage_count) {
 #ifdef DEBUG_MAPGEN
             update_progress_step(5, hidden, passage_count);
 #endif
+        } else {
+            mapgen_stats.passage_rejects++;
         }
 
         // Remove used candidate (swap with last, decrement count)
@@ -698,6 +773,23 @@ void place_hidden_passages(unsigned char passage_count) {
 // DECOY CORRIDOR SYSTEM (dead-end corridors that mislead the player)
 // =============================================================================
 
+// Decoy path is clear and its dead end is not adjacent to existing
+// walkable tiles (0x0C = FLOOR|DOOR); rejections are counted by reason
+static unsigned char decoy_path_valid(unsigned char door_x, unsigned char door_y,
+                                      unsigned char end_x, unsigned char end_y,
+                                      unsigned char wall_side, unsigned char corridor_type) {
+    if (!process_corridor_path(door_x, door_y, end_x, end_y, wall_side, corridor_type,
+                               CORRIDOR_MODE_CHECK, TILE_FLOOR)) {
+        mapgen_stats.decoy_path_rejects++;
+        return 0;
+    }
+    if (check_adjacent_tile_types(end_x, end_y, 0x0C, 1)) {
+        mapgen_stats.decoy_adjacent_rejects++;
+        return 0;
+    }
+    return 1;
+}
+
 // Create a decoy corridor - dead-end that looks like a real passage
 static unsigned char create_decoy_corridor(unsigned char room_idx, unsigned char wall_side) {
     Room *room = &room_list[room_idx];
@@ -773,12 +865,10 @@ static unsigned char create_decoy_corridor(unsigned char room_idx, unsigned char
     }
 
     // Validate path (catches room collisions and MST corridor crossings)
-    // Also check endpoint is not adjacent to existing walkable tiles (0x0C = FLOOR|DOOR)
     unsigned char corridor_type = determine_corridor_type(door_x, door_y, endpoint_x, endpoint_y);
-    if (!process_corridor_path(door_x, door_y, endpoint_x, endpoint_y, wall_side, corridor_type,
-                               CORRIDOR_MODE_CHECK, TILE_FLOOR) ||
-        check_adjacent_tile_types(endpoint_x, endpoint_y, 0x0C, 1)) {
+    if (!decoy_path_valid(door_x, door_y, endpoint_x, endpoint_y, wall_side, corridor_type)) {
         // Shaped/long failed or endpoint too close to walkable - try minimum straight
+        mapgen_stats.decoy_fallbacks++;
         corridor_len = 4;
         endpoint_x = door_x;
         endpoint_y = door_y;
@@ -788,14 +878,13 @@ static unsigned char create_decoy_corridor(unsigned char room_idx, unsigned char
             endpoint_x = (wall_side & 1) ? door_x + corridor_len : door_x - corridor_len;
         corridor_type = 0;
 
-        if (!process_corridor_path(door_x, door_y, endpoint_x, endpoint_y, wall_side, corridor_type,
-                                   CORRIDOR_MODE_CHECK, TILE_FLOOR) ||
-            check_adjacent_tile_types(endpoint_x, endpoint_y, 0x0C, 1)) {
+        if (!decoy_path_valid(door_x, door_y, endpoint_x, endpoint_y, wall_side, corridor_type)) {
             return 0;  // Even minimum straight doesn't work or endpoint invalid
         }
     }
 
     // Draw the corridor (endpoint included by build_corridor_line)
+    region_begin_corridor(room_idx, REGION_NONE);
     process_corridor_path(door_x, door_y, endpoint_x, endpoint_y, wall_side, corridor_type,
                           CORRIDOR_MODE_DRAW, TILE_FLOOR);
 
@@ -820,11 +909,11 @@ void place_decoy_corridors(unsigned char corridor_count) {
     if (room_count == 0 || corridor_count == 0) return;
 
     // Collect all eligible room+wall candidates
-    static unsigned char cand_room[80];  // max 20 rooms × 4 walls
-    static unsigned char cand_wall[80];
+    static unsigned char cand_room[MAX_ROOMS * 4];  // 4 walls per room
+    static unsigned char cand_wall[MAX_ROOMS * 4];
     unsigned char cand_count = 0;
 
-    for (unsigned char r = 0; r < room_count && cand_count < 80; r++) {
+    for (unsigned char r = 0; r < room_count && cand_count < MAX_ROOMS * 4; r++) {
         Room *room = &room_list[r];
 
         // Skip hidden rooms entirely
@@ -854,6 +943,7 @@ void place_decoy_corridors(unsigned char corridor_count) {
     while (placed < corridor_count && cand_count > 0) {
         unsigned char idx = rnd(cand_count);
 
+        mapgen_stats.decoy_attempts++;
         if (create_decoy_corridor(cand_room[idx], cand_wall[idx])) {
             placed++;
             total_decoys++;
@@ -974,9 +1064,13 @@ void place_niches(unsigned char niche_count) {
             // Phase 3: Niche placement progress
             update_progress_step(3, niches_placed, niche_count);
 #endif
+        } else {
+            mapgen_stats.niche_rejects++;
         }
         attempts++;
     }
+
+    mapgen_stats.niche_attempts = attempts;
 }
 
 // =============================================================================
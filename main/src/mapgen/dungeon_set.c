@@ -0,0 +1,101 @@
+// =============================================================================
+// DUNGEON SET - A Quest's Levels Planned from One Master Seed
+// Implementation - Oscar64 Optimized
+// =============================================================================
+
+#include "dungeon_set.h"
+#include "level_pack.h"
+#include "mapgen_api.h"
+#include "mapgen_types.h"
+#include "mapgen_internal.h"
+#include "mapgen_utils.h"
+
+// =============================================================================
+// GLOBAL STATE DEFINITIONS
+// =============================================================================
+
+DungeonLevelSummary dungeon_set[DUNGEON_SET_MAX_LEVELS];    // 96 bytes
+unsigned char dungeon_set_count;                            // 1 byte
+
+// =============================================================================
+// PLANNING (generator code)
+// =============================================================================
+
+#ifdef MAPGEN_OVERLAY
+#pragma code(mgcode)
+#endif
+
+unsigned char MAPGEN_ENTRY(mapgen_generate_dungeon_set)(unsigned int master_seed, unsigned char depth) {
+    MapConfig config;
+    MapParameters params;
+
+    dungeon_set_count = 0;
+    if (depth == 0 || depth > DUNGEON_SET_MAX_LEVELS) return 0;
+
+    // Hidden rooms, niches and deception as in tools/levelpack
+    config.hidden_rooms = LEVEL_MEDIUM;
+    config.niches = LEVEL_MEDIUM;
+    config.deception = LEVEL_MEDIUM;
+
+    unsigned int seed = master_seed;
+    mapgen_pin_up_stairs(255, 255);
+
+    for (unsigned char level = 0; level < depth; level++) {
+        DungeonLevelSummary *summary = &dungeon_set[level];
+        seed = dungeon_set_next_seed(seed);
+
+        config.map_size = (PresetLevel)dungeon_set_map_size(level);
+        validate_and_adjust_config(&config, &params);
+        mapgen_set_parameters(&params);
+
+        // generate_level() up to the stairs: they are picked on the
+        // corridor graph, and the RNG sequence is the same as in the
+        // full generation
+        mapgen_init(seed);
+        reset_all_generation_data();
+        if (!generate_layout() || room_count < 2) break;
+
+        unsigned char up_room, down_room;
+        select_stair_rooms(&up_room, &down_room);
+
+        summary->seed = seed;
+        summary->presets = LEVEL_PACK_PRESETS(config.map_size, config.hidden_rooms,
+                                              config.niches, config.deception);
+        summary->up_x = room_list[up_room].center_x;
+        summary->up_y = room_list[up_room].center_y;
+        summary->down_x = room_list[down_room].center_x;
+        summary->down_y = room_list[down_room].center_y;
+        summary->rooms = room_count;
+        dungeon_set_count++;
+
+        // Next level starts under these down stairs
+        mapgen_pin_up_stairs(summary->down_x, summary->down_y);
+    }
+
+    mapgen_pin_up_stairs(255, 255);
+    return dungeon_set_count;
+}
+
+#ifdef MAPGEN_OVERLAY
+#pragma code(code)
+#endif
+
+// =============================================================================
+// LEVEL ENTRY (resident)
+// =============================================================================
+
+unsigned char dungeon_set_enter(unsigned char level) {
+    if (level >= dungeon_set_count) return 0;
+    const DungeonLevelSummary *summary = &dungeon_set[level];
+    unsigned char presets = summary->presets;
+
+    if (level > 0) {
+        mapgen_pin_up_stairs(dungeon_set[level - 1].down_x, dungeon_set[level - 1].down_y);
+    }
+    mapgen_init(summary->seed);
+    mapgen_set_depth(level);
+    unsigned char result = mapgen_generate_with_params(LEVEL_PACK_PRESET(presets, 0), LEVEL_PACK_PRESET(presets, 1),
+                                                       LEVEL_PACK_PRESET(presets, 2), LEVEL_PACK_PRESET(presets, 3));
+    mapgen_pin_up_stairs(255, 255);
+    return result == 0;
+}
@@ -0,0 +1,82 @@
+#ifndef DUNGEON_SET_H
+#define DUNGEON_SET_H
+
+// =============================================================================
+// DUNGEON SET - A Quest's Levels Planned from One Master Seed
+// =============================================================================
+//
+// mapgen_generate_dungeon_set() plans every level of a Quest at boot:
+// - level seeds follow from the master seed (dungeon_set_next_seed, the
+//   same derivation tools/levelpack uses for a quest seed)
+// - map size grows with depth (dungeon_set_map_size)
+// - the up stairs of each level are pinned under the down stairs of the
+//   level above: create_rooms() centres the first room on the pin
+//
+// Stairs are the ends of the longest walk through the corridor graph,
+// so planning a level runs generate_layout() (rooms, corridors, hidden
+// rooms, niches, deception) and the stair selection - no population.
+// Per level only a DungeonLevelSummary is kept.
+//
+// dungeon_set_enter() generates a planned level in full later: same
+// seed, presets, depth and pin, so rooms and stairs match the summary.
+//
+// Memory: 96 bytes summaries + 1 byte count
+//
+// =============================================================================
+
+#include "mapgen_config.h"
+
+enum DungeonSetConstants {
+    DUNGEON_SET_MAX_LEVELS = 12         // Quest mode depth
+};
+
+// Level summary (8 bytes)
+typedef struct {
+    unsigned int seed;                  // mapgen_init() seed
+    unsigned char presets;              // LEVEL_PACK_PRESETS()
+    unsigned char up_x, up_y;           // Up stairs (= down stairs above when pinned)
+    unsigned char down_x, down_y;       // Down stairs
+    unsigned char rooms;                // Rooms placed
+} DungeonLevelSummary;
+
+// Seed of the next level: one mapgen LCG step, never 0
+static inline unsigned int dungeon_set_next_seed(unsigned int seed) {
+    seed = seed * 75 + 74;
+    return seed ? seed : 1;
+}
+
+// Map size by depth: SMALL for levels 0-3, MEDIUM 4-7, LARGE 8-11
+static inline unsigned char dungeon_set_map_size(unsigned char level) {
+    return level < 4 ? LEVEL_SMALL : level < 8 ? LEVEL_MEDIUM : LEVEL_LARGE;
+}
+
+// =============================================================================
+// GLOBAL STATE DECLARATIONS
+// =============================================================================
+
+extern DungeonLevelSummary dungeon_set[DUNGEON_SET_MAX_LEVELS];    // 96 bytes
+extern unsigned char dungeon_set_count;                            // Levels planned
+
+// =============================================================================
+// DUNGEON SET FUNCTIONS
+// =============================================================================
+
+/**
+ * @brief Plan a Quest: seeds, presets, stairs and room counts per level
+ * @param master_seed Quest seed, level 0 uses dungeon_set_next_seed(master_seed)
+ * @param depth Levels to plan (1 to DUNGEON_SET_MAX_LEVELS)
+ * @return Levels planned (dungeon_set_count), 0 if depth is out of range
+ *
+ * Replaces the current level: call it before entering the first one.
+ * Planning stops early at a level with fewer than two rooms.
+ */
+unsigned char mapgen_generate_dungeon_set(unsigned int master_seed, unsigned char depth);
+
+/**
+ * @brief Generate a planned level in full
+ * @param level Level number (< dungeon_set_count)
+ * @return 1 on success, 0 on failure or level not planned
+ */
+unsigned char dungeon_set_enter(unsigned char level);
+
+#endif // DUNGEON_SET_H
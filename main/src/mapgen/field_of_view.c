@@ -0,0 +1,189 @@
+// =============================================================================
+// FIELD OF VIEW - Recursive Shadowcasting
+// Implementation - Oscar64 Optimized
+// =============================================================================
+
+#include "field_of_view.h"
+#include "fog_of_war.h"
+#include "region_map.h"
+#include "mapgen_types.h"
+#include "mapgen_internal.h"
+#include "mapgen_utils.h"
+#include "tmea_core.h"
+
+extern MapParameters current_params;
+
+// =============================================================================
+// GLOBAL STATE DEFINITIONS
+// =============================================================================
+
+unsigned char fov_visible[FOV_WINDOW_SIZE][FOV_ROW_BYTES];  // 51 bytes
+unsigned char fov_origin_x, fov_origin_y;                   // 2 bytes
+unsigned char fov_room = 255;                               // 1 byte
+
+// Active octant transform and radius (set before each octant cast)
+static signed char fov_xx, fov_xy, fov_yx, fov_yy;
+static unsigned char fov_radius;
+
+// =============================================================================
+// LOOKUP TABLES (ROM)
+// =============================================================================
+
+// Octant transforms: map = origin + col * xx + row * xy, origin + col * yx + row * yy
+static const signed char fov_oct_xx[8] = { 1,  0,  0, -1, -1,  0,  0,  1 };
+static const signed char fov_oct_xy[8] = { 0,  1, -1,  0,  0, -1,  1,  0 };
+static const signed char fov_oct_yx[8] = { 0,  1,  1,  0,  0, -1, -1,  0 };
+static const signed char fov_oct_yy[8] = { 1,  0,  0,  1, -1,  0,  0, -1 };
+
+// Upper edge slope of cell (row, col): (col + 0.5) / (row - 0.5), 1.0 = 128
+// Index: [row][col], col <= row, clamped to 255
+static const unsigned char fov_slope_high[FOV_MAX_RADIUS + 1][FOV_MAX_RADIUS + 1] = {
+    {  0,   0,   0,   0,   0,   0},
+    {128, 255,   0,   0,   0,   0},
+    { 43, 128, 213,   0,   0,   0},
+    { 26,  77, 128, 179,   0,   0},
+    { 18,  55,  91, 128, 165,   0},
+    { 14,  43,  71, 100, 128, 156}
+};
+
+// Lower edge slope of cell (row, col): (col - 0.5) / (row + 0.5), 1.0 = 128
+// Index: [row][col], col <= row, clamped to 0
+static const unsigned char fov_slope_low[FOV_MAX_RADIUS + 1][FOV_MAX_RADIUS + 1] = {
+    {  0,   0,   0,   0,   0,   0},
+    {  0,  43,   0,   0,   0,   0},
+    {  0,  26,  77,   0,   0,   0},
+    {  0,  18,  55,  91,   0,   0},
+    {  0,  14,  43,  71, 100,   0},
+    {  0,  12,  35,  58,  81, 105}
+};
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+static inline void fov_mark(unsigned char wx, unsigned char wy) {
+    fov_visible[wy][wx >> 3] |= fog_bit_mask[wx & 7];
+}
+
+// Opaque tiles: solid rock, walls and undiscovered secret doors
+static unsigned char fov_blocks_sight(unsigned char x, unsigned char y) {
+    unsigned char tile = get_compact_tile(x, y);
+    if (tile == TILE_WALL || tile == TILE_EMPTY) return 1;
+    if (tile == TILE_MARKER) return is_door_secret(x, y);
+    return 0;
+}
+
+/**
+ * @brief Scan one octant from row outward between two slopes
+ * @param row First row (distance from origin) to scan
+ * @param start Upper slope bound (1.0 = 128)
+ * @param end Lower slope bound
+ *
+ * Recurses once per wall run that splits the visible wedge;
+ * depth is bounded by fov_radius.
+ */
+static void fov_cast_octant(unsigned char row, unsigned char start, unsigned char end) {
+    unsigned char new_start = 0;
+
+    if (start < end) return;
+
+    for (unsigned char j = row; j <= fov_radius; j++) {
+        unsigned char blocked = 0;
+        unsigned char limit = fog_radius_span[fov_radius][j];
+        unsigned char c = j + 1;
+
+        // Columns from the octant's outer diagonal (col = row) towards its axis
+        while (c > 0) {
+            c--;
+            unsigned char high = fov_slope_high[j][c];
+            unsigned char low = fov_slope_low[j][c];
+
+            if (start < low) continue;      // Cell above visible wedge
+            if (end > high) break;          // Rest of row below visible wedge
+
+            // Transform octant (col, row) to map offset; dx = -col, dy = -row
+            signed char ox = -(signed char)c * fov_xx - (signed char)j * fov_xy;
+            signed char oy = -(signed char)c * fov_yx - (signed char)j * fov_yy;
+            unsigned char x = fov_origin_x + ox;
+            unsigned char y = fov_origin_y + oy;
+            unsigned char opaque = 1;
+
+            if (x < current_params.map_width && y < current_params.map_height) {
+                if (c <= limit) {
+                    fov_mark(FOV_WINDOW_RADIUS + ox, FOV_WINDOW_RADIUS + oy);
+                }
+                opaque = fov_blocks_sight(x, y);
+            }
+
+            if (blocked) {
+                if (opaque) {
+                    new_start = low;
+                    continue;
+                }
+                blocked = 0;
+                start = new_start;
+            } else if (opaque && j < fov_radius) {
+                blocked = 1;
+                fov_cast_octant(j + 1, start, high);
+                new_start = low;
+            }
+        }
+        if (blocked) break;
+    }
+}
+
+static void fov_cast_radius(unsigned char radius) {
+    fov_radius = (radius > FOV_MAX_RADIUS) ? FOV_MAX_RADIUS : radius;
+    fov_mark(FOV_WINDOW_RADIUS, FOV_WINDOW_RADIUS);
+
+    for (unsigned char oct = 0; oct < 8; oct++) {
+        fov_xx = fov_oct_xx[oct];
+        fov_xy = fov_oct_xy[oct];
+        fov_yx = fov_oct_yx[oct];
+        fov_yy = fov_oct_yy[oct];
+        fov_cast_octant(1, 128, 0);
+    }
+}
+
+// =============================================================================
+// FOV FUNCTIONS
+// =============================================================================
+
+void fov_update(unsigned char px, unsigned char py, unsigned char has_light) {
+    unsigned char *ptr = &fov_visible[0][0];
+    for (unsigned char i = 0; i < FOV_WINDOW_SIZE * FOV_ROW_BYTES; i++) {
+        *ptr++ = 0;
+    }
+
+    fov_origin_x = px;
+    fov_origin_y = py;
+
+    fov_room = region_at(px, py);
+    if (!region_is_room(fov_room)) {
+        fov_room = 255;
+        fov_cast_radius(FOV_RADIUS_CORRIDOR);
+        return;
+    }
+
+    Room *room = &room_list[fov_room];
+    if (room->state & ROOM_DARK) {
+        fov_cast_radius(has_light ? FOV_RADIUS_LIT : FOV_RADIUS_DARK);
+        return;
+    }
+
+    // Lit room early-out: room plus walls always fits the 17x17 window
+    unsigned char wx0 = FOV_WINDOW_RADIUS + (room->x - 1) - px;
+    unsigned char wx1 = wx0 + room->w + 1;
+    unsigned char wy = FOV_WINDOW_RADIUS + (room->y - 1) - py;
+    for (unsigned char i = 0; i < room->h + 2; i++) {
+        fog_set_span(fov_visible[wy + i], wx0, wx1);
+    }
+}
+
+unsigned char fov_is_visible(unsigned char x, unsigned char y) {
+    unsigned char wx = x - fov_origin_x + FOV_WINDOW_RADIUS;
+    unsigned char wy = y - fov_origin_y + FOV_WINDOW_RADIUS;
+
+    if (wx >= FOV_WINDOW_SIZE || wy >= FOV_WINDOW_SIZE) return 0;
+    return fov_visible[wy][wx >> 3] & fog_bit_mask[wx & 7];
+}
@@ -0,0 +1,75 @@
+#ifndef FIELD_OF_VIEW_H
+#define FIELD_OF_VIEW_H
+
+// =============================================================================
+// FIELD OF VIEW - Recursive Shadowcasting
+// =============================================================================
+//
+// Per-turn visibility around the player on the packed compact_map.
+//
+// Lighting rules (game-architecture-plan.md 7.3):
+// - Lit room:                  whole room visible (early-out, no casting)
+// - Dark room + light source:  radius 5
+// - Dark room, no light:       radius 1
+// - Corridors / doorways:      radius 3
+//
+// Algorithm:
+// - Classic 8-octant recursive shadowcasting
+// - Cell edge slopes precomputed in ROM as 8-bit fixed point (1.0 = 128),
+//   circle limits per radius shared with the fog module (fog_radius_span)
+// - Walls tested with get_compact_tile(); secret doors block until revealed
+//
+// Result:
+// - 17x17 visible-cells bitset centered on the player (3 bytes per row),
+//   large enough for the lit-room early-out from any position in a room
+//
+// Performance: ~6000 cycles (radius 3 corridor), ~1500 cycles (lit room)
+// Memory: 51 bytes bitset + 3 bytes state + ~80 bytes ROM tables
+//
+// =============================================================================
+
+#include "mapgen_types.h"
+
+enum FovConstants {
+    FOV_MAX_RADIUS = 5,                                 // Largest cast radius
+    FOV_WINDOW_RADIUS = 8,                              // Covers any room + walls
+    FOV_WINDOW_SIZE = FOV_WINDOW_RADIUS * 2 + 1,        // 17 tiles
+    FOV_ROW_BYTES = (FOV_WINDOW_SIZE + 7) / 8,          // 3 bytes per row
+    FOV_RADIUS_LIT = 5,                                 // Dark room with light
+    FOV_RADIUS_DARK = 1,                                // Dark room, no light
+    FOV_RADIUS_CORRIDOR = 3                             // Corridors and doorways
+};
+
+// =============================================================================
+// GLOBAL STATE DECLARATIONS
+// =============================================================================
+
+extern unsigned char fov_visible[FOV_WINDOW_SIZE][FOV_ROW_BYTES];  // 51 bytes
+extern unsigned char fov_origin_x, fov_origin_y;                   // Player position
+extern unsigned char fov_room;                                     // Room or 255
+
+// =============================================================================
+// FOV FUNCTIONS
+// =============================================================================
+
+/**
+ * @brief Recompute visibility for a player standing at (px, py)
+ * @param px Player X
+ * @param py Player Y
+ * @param has_light Non-zero if a torch or Scroll of Light is active
+ *
+ * Clears the bitset, then either marks the whole lit room (early-out)
+ * or casts light with the radius chosen by the lighting rules.
+ * Sets fov_room to the room index, or 255 outside rooms.
+ */
+void fov_update(unsigned char px, unsigned char py, unsigned char has_light);
+
+/**
+ * @brief Check if tile was visible in the last fov_update()
+ * @param x Tile X
+ * @param y Tile Y
+ * @return Non-zero if visible, 0 otherwise
+ */
+unsigned char fov_is_visible(unsigned char x, unsigned char y);
+
+#endif // FIELD_OF_VIEW_H
@@ -0,0 +1,320 @@
+// =============================================================================
+// FLOW FIELD - Shared Player Distance Map for Monster Pursuit
+// Implementation - Oscar64 Optimized
+// =============================================================================
+
+#include "flow_field.h"
+#include "fog_of_war.h"
+#include "region_map.h"
+#include "mapgen_types.h"
+#include "mapgen_internal.h"
+#include "mapgen_utils.h"
+#include "tmea_core.h"
+
+extern MapParameters current_params;
+
+// =============================================================================
+// GLOBAL STATE DEFINITIONS
+// =============================================================================
+
+unsigned char flow_dist[FLOW_H][FLOW_W];                    // 384 bytes
+unsigned char flow_origin_x, flow_origin_y;                 // 2 bytes
+
+static unsigned char flow_walk[FLOW_H][FLOW_ROW_BYTES];     // 48 bytes
+static unsigned char flow_qx[FLOW_QUEUE_SIZE];              // 64 bytes
+static unsigned char flow_qy[FLOW_QUEUE_SIZE];              // 64 bytes
+static unsigned char flow_q_head, flow_q_tail, flow_q_count;
+static unsigned char flow_overflow;
+
+static unsigned char flow_src_x, flow_src_y;                // Player (window coords)
+static unsigned char flow_region = REGION_NONE;             // Player region at rebuild
+static unsigned char flow_valid;
+
+// =============================================================================
+// LOOKUP TABLES (ROM)
+// =============================================================================
+
+// 4-neighbor offsets (N, E, S, W)
+static const signed char flow_dir_x[4] = { 0, 1, 0, -1 };
+static const signed char flow_dir_y[4] = { -1, 0, 1, 0 };
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+static inline unsigned char flow_walkable(unsigned char lx, unsigned char ly) {
+    return flow_walk[ly][lx >> 3] & fog_bit_mask[lx & 7];
+}
+
+static inline void flow_queue_reset(void) {
+    flow_q_head = 0;
+    flow_q_tail = 0;
+    flow_q_count = 0;
+    flow_overflow = 0;
+}
+
+static void flow_push(unsigned char lx, unsigned char ly) {
+    if (flow_q_count >= FLOW_QUEUE_SIZE) {
+        flow_overflow = 1;
+        return;
+    }
+    flow_qx[flow_q_tail] = lx;
+    flow_qy[flow_q_tail] = ly;
+    flow_q_tail = (flow_q_tail + 1) & (FLOW_QUEUE_SIZE - 1);
+    flow_q_count++;
+}
+
+static void flow_pop(unsigned char *lx, unsigned char *ly) {
+    *lx = flow_qx[flow_q_head];
+    *ly = flow_qy[flow_q_head];
+    flow_q_head = (flow_q_head + 1) & (FLOW_QUEUE_SIZE - 1);
+    flow_q_count--;
+}
+
+// Mark all window tiles of a region walkable
+static void flow_add_region(unsigned char id) {
+    RegionIter it;
+    unsigned char x, y;
+
+    region_iter_begin(&it, id);
+    while (region_iter_next(&it, &x, &y)) {
+        unsigned char lx = x - flow_origin_x;
+        unsigned char ly = y - flow_origin_y;
+        if (lx >= FLOW_W || ly >= FLOW_H) continue;
+        if (get_compact_tile(x, y) == TILE_MARKER && is_door_secret(x, y)) continue;
+        flow_walk[ly][lx >> 3] |= fog_bit_mask[lx & 7];
+    }
+}
+
+// Build walkability mask: player region plus regions adjacent to it
+static void flow_build_mask(void) {
+    unsigned char *ptr = &flow_walk[0][0];
+    for (unsigned char i = 0; i < FLOW_H * FLOW_ROW_BYTES; i++) {
+        *ptr++ = 0;
+    }
+
+    // Player tile is always walkable (covers niches outside any region)
+    flow_walk[flow_src_y][flow_src_x >> 3] |= fog_bit_mask[flow_src_x & 7];
+
+    if (flow_region == REGION_NONE) return;
+    flow_add_region(flow_region);
+
+    if (region_is_room(flow_region)) {
+        unsigned char added = 1;
+        for (unsigned char c = 0; c < region_corridor_count && added < FLOW_MAX_REGIONS; c++) {
+            if (region_corridor_room_a[c] == flow_region || region_corridor_room_b[c] == flow_region) {
+                flow_add_region(REGION_CORRIDOR_BASE + c);
+                added++;
+            }
+        }
+    } else {
+        unsigned char c = flow_region - REGION_CORRIDOR_BASE;
+        if (region_corridor_room_a[c] != REGION_NONE) flow_add_region(region_corridor_room_a[c]);
+        if (region_corridor_room_b[c] != REGION_NONE) flow_add_region(region_corridor_room_b[c]);
+    }
+}
+
+/**
+ * @brief Relax distances outward from queued cells
+ *
+ * FIFO label-correcting relaxation: plain BFS when seeded with one source,
+ * also settles multiple seeds with different distances (repair pass).
+ */
+static void flow_relax(void) {
+    unsigned char lx, ly;
+
+    while (flow_q_count) {
+        flow_pop(&lx, &ly);
+        unsigned char d = flow_dist[ly][lx] + 1;
+        if (d >= FLOW_UNREACHED) continue;
+
+        for (unsigned char dir = 0; dir < 4; dir++) {
+            unsigned char nx = lx + flow_dir_x[dir];
+            unsigned char ny = ly + flow_dir_y[dir];
+            if (nx >= FLOW_W || ny >= FLOW_H) continue;
+            if (!flow_walkable(nx, ny)) continue;
+            if (flow_dist[ny][nx] > d) {
+                flow_dist[ny][nx] = d;
+                flow_push(nx, ny);
+            }
+        }
+    }
+}
+
+// Check if cell (old distance d > 0) still has a neighbor at distance d - 1
+static unsigned char flow_has_support(unsigned char lx, unsigned char ly, unsigned char d) {
+    for (unsigned char dir = 0; dir < 4; dir++) {
+        unsigned char nx = lx + flow_dir_x[dir];
+        unsigned char ny = ly + flow_dir_y[dir];
+        if (nx >= FLOW_W || ny >= FLOW_H) continue;
+        if (flow_dist[ny][nx] == d - 1) return 1;   // Affected cells have bit 7 set
+    }
+    return 0;
+}
+
+// Smallest valid neighbor distance + 1, or FLOW_UNREACHED
+static unsigned char flow_best_neighbor(unsigned char lx, unsigned char ly) {
+    unsigned char best = FLOW_UNREACHED;
+    for (unsigned char dir = 0; dir < 4; dir++) {
+        unsigned char nx = lx + flow_dir_x[dir];
+        unsigned char ny = ly + flow_dir_y[dir];
+        if (nx >= FLOW_W || ny >= FLOW_H) continue;
+        unsigned char d = flow_dist[ny][nx];
+        if (d < best) best = d;
+    }
+    return (best < FLOW_UNREACHED - 1) ? best + 1 : FLOW_UNREACHED;
+}
+
+// =============================================================================
+// FIELD UPDATES
+// =============================================================================
+
+static void flow_rebuild(unsigned char px, unsigned char py) {
+    unsigned char w = current_params.map_width;
+    unsigned char h = current_params.map_height;
+
+    // Center window on player, clamped to map
+    flow_origin_x = (px > FLOW_W / 2) ? px - FLOW_W / 2 : 0;
+    flow_origin_y = (py > FLOW_H / 2) ? py - FLOW_H / 2 : 0;
+    if (w > FLOW_W && flow_origin_x > w - FLOW_W) flow_origin_x = w - FLOW_W;
+    if (h > FLOW_H && flow_origin_y > h - FLOW_H) flow_origin_y = h - FLOW_H;
+    if (w <= FLOW_W) flow_origin_x = 0;
+    if (h <= FLOW_H) flow_origin_y = 0;
+
+    flow_src_x = px - flow_origin_x;
+    flow_src_y = py - flow_origin_y;
+    flow_region = region_at(px, py);
+    flow_build_mask();
+
+    unsigned char *ptr = &flow_dist[0][0];
+    for (unsigned short i = 0; i < FLOW_H * FLOW_W; i++) {
+        *ptr++ = FLOW_UNREACHED;
+    }
+
+    flow_queue_reset();
+    flow_dist[flow_src_y][flow_src_x] = 0;
+    flow_push(flow_src_x, flow_src_y);
+    flow_relax();
+
+    // Frontier never exceeds the queue in room/corridor shaped areas;
+    // if it ever does, far cells simply stay unreached
+    flow_valid = 1;
+}
+
+/**
+ * @brief Move field source to a new cell inside the same window
+ * @param nx, ny New player position (window coords)
+ * @return 1 on success, 0 if the queue overflowed (caller rebuilds)
+ */
+static unsigned char flow_move_source(unsigned char nx, unsigned char ny) {
+    unsigned char ox = flow_src_x;
+    unsigned char oy = flow_src_y;
+    unsigned char lx, ly;
+
+    // Pass 1: decrease - distances now also measured from the new source
+    flow_queue_reset();
+    flow_dist[ny][nx] = 0;
+    flow_push(nx, ny);
+    flow_relax();
+    if (flow_overflow) return 0;
+
+    // Pass 2a: raise - cells whose every shortest path ends at the old
+    // source lose their support; find them top-down from the old source
+    flow_dist[oy][ox] |= FLOW_AFFECTED;
+    flow_push(ox, oy);
+    while (flow_q_count) {
+        flow_pop(&lx, &ly);
+        unsigned char d = (flow_dist[ly][lx] & ~FLOW_AFFECTED) + 1;
+
+        for (unsigned char dir = 0; dir < 4; dir++) {
+            unsigned char cx = lx + flow_dir_x[dir];
+            unsigned char cy = ly + flow_dir_y[dir];
+            if (cx >= FLOW_W || cy >= FLOW_H) continue;
+            if (flow_dist[cy][cx] != d) continue;
+            if (flow_has_support(cx, cy, d)) continue;
+            flow_dist[cy][cx] |= FLOW_AFFECTED;
+            flow_push(cx, cy);
+        }
+    }
+    if (flow_overflow) return 0;
+
+    // Pass 2b: re-seed affected cells from their valid neighbors in one
+    // scan, other cells cost a flag test. Cells still flagged count as
+    // unreached (bit 7); a seed taken from a cell re-seeded earlier in
+    // the scan is an upper bound the relaxation lowers.
+    unsigned char *cell = &flow_dist[0][0];
+    for (ly = 0; ly < FLOW_H; ly++) {
+        for (lx = 0; lx < FLOW_W; lx++) {
+            if (*cell & FLOW_AFFECTED) {
+                unsigned char d = flow_best_neighbor(lx, ly);
+                *cell = d;
+                if (d < FLOW_UNREACHED) flow_push(lx, ly);
+            }
+            cell++;
+        }
+    }
+    flow_relax();
+    if (flow_overflow) return 0;
+
+    flow_src_x = nx;
+    flow_src_y = ny;
+    return 1;
+}
+
+void flow_update(unsigned char px, unsigned char py) {
+    unsigned char lx = px - flow_origin_x;
+    unsigned char ly = py - flow_origin_y;
+
+    if (flow_valid && lx == flow_src_x && ly == flow_src_y) return;
+
+    // Incremental only for moves that keep the region, window and mask valid
+    if (flow_valid &&
+        lx >= FLOW_EDGE_MARGIN && lx < FLOW_W - FLOW_EDGE_MARGIN &&
+        ly >= FLOW_EDGE_MARGIN && ly < FLOW_H - FLOW_EDGE_MARGIN &&
+        flow_walkable(lx, ly) && region_at(px, py) == flow_region) {
+        if (flow_move_source(lx, ly)) return;
+    }
+
+    flow_rebuild(px, py);
+}
+
+void flow_invalidate(void) {
+    flow_valid = 0;
+}
+
+// =============================================================================
+// QUERIES
+// =============================================================================
+
+unsigned char flow_distance(unsigned char x, unsigned char y) {
+    unsigned char lx = x - flow_origin_x;
+    unsigned char ly = y - flow_origin_y;
+
+    if (!flow_valid || lx >= FLOW_W || ly >= FLOW_H) return FLOW_UNREACHED;
+    return flow_dist[ly][lx];
+}
+
+unsigned char flow_next_step(unsigned char x, unsigned char y,
+                             unsigned char *nx, unsigned char *ny) {
+    unsigned char lx = x - flow_origin_x;
+    unsigned char ly = y - flow_origin_y;
+
+    if (!flow_valid || lx >= FLOW_W || ly >= FLOW_H) return 0;
+
+    unsigned char best = flow_dist[ly][lx];
+    if (best == FLOW_UNREACHED || best <= 1) return 0;
+
+    unsigned char found = 0;
+    for (unsigned char dir = 0; dir < 4; dir++) {
+        unsigned char cx = lx + flow_dir_x[dir];
+        unsigned char cy = ly + flow_dir_y[dir];
+        if (cx >= FLOW_W || cy >= FLOW_H) continue;
+        if (flow_dist[cy][cx] < best) {
+            best = flow_dist[cy][cx];
+            *nx = cx + flow_origin_x;
+            *ny = cy + flow_origin_y;
+            found = 1;
+        }
+    }
+    return found;
+}
@@ -0,0 +1,154 @@
+// =============================================================================
+// FOG OF WAR - Explored Tile Bitplane
+// Implementation - Oscar64 Optimized
+// =============================================================================
+
+#include "fog_of_war.h"
+#include "region_map.h"
+#include "mapgen_types.h"
+#include "mapgen_internal.h"
+#include "mapgen_utils.h"
+
+extern MapParameters current_params;
+
+// =============================================================================
+// GLOBAL STATE DEFINITIONS
+// =============================================================================
+
+unsigned char fog_plane[FOG_PLANE_SIZE];                // 800 bytes
+unsigned char fog_room_seen[FOG_ROOM_MASK_SIZE];        // 4 bytes
+unsigned char fog_stride;                               // 1 byte
+unsigned short fog_plane_bytes;                         // 2 bytes
+
+// =============================================================================
+// LOOKUP TABLES (ROM)
+// =============================================================================
+
+const unsigned char fog_bit_mask[8] = {
+    0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80
+};
+
+// Bits from (x & 7) up to bit 7 - first byte of a span
+const unsigned char fog_mask_from[8] = {
+    0xFF, 0xFE, 0xFC, 0xF8, 0xF0, 0xE0, 0xC0, 0x80
+};
+
+// Bits from bit 0 up to (x & 7) - last byte of a span
+const unsigned char fog_mask_to[8] = {
+    0x01, 0x03, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF
+};
+
+// Half-width of the reveal circle per row offset: isqrt(r*r + r - dy*dy)
+// Index: [radius][abs(dy)]
+const unsigned char fog_radius_span[FOG_MAX_RADIUS + 1][FOG_MAX_RADIUS + 1] = {
+    {0, 0, 0, 0, 0, 0},
+    {1, 1, 0, 0, 0, 0},
+    {2, 2, 1, 0, 0, 0},
+    {3, 3, 2, 1, 0, 0},
+    {4, 4, 4, 3, 2, 0},
+    {5, 5, 5, 4, 3, 2}
+};
+
+// =============================================================================
+// INITIALIZATION
+// =============================================================================
+
+void fog_init(void) {
+    fog_stride = (current_params.map_width + 7) >> 3;
+    fog_plane_bytes = (unsigned short)fog_stride * current_params.map_height;
+
+    unsigned char *ptr = fog_plane;
+    for (unsigned short i = 0; i < fog_plane_bytes; i++) {
+        *ptr++ = 0;
+    }
+
+    for (unsigned char i = 0; i < FOG_ROOM_MASK_SIZE; i++) {
+        fog_room_seen[i] = 0;
+    }
+}
+
+// =============================================================================
+// REVEAL FUNCTIONS
+// =============================================================================
+
+void fog_set_span(unsigned char *row, unsigned char x0, unsigned char x1) {
+    unsigned char b0 = x0 >> 3;
+    unsigned char b1 = x1 >> 3;
+
+    if (b0 == b1) {
+        row[b0] |= fog_mask_from[x0 & 7] & fog_mask_to[x1 & 7];
+        return;
+    }
+
+    row[b0] |= fog_mask_from[x0 & 7];
+    for (unsigned char b = b0 + 1; b < b1; b++) {
+        row[b] = 0xFF;
+    }
+    row[b1] |= fog_mask_to[x1 & 7];
+}
+
+void fog_reveal_span(unsigned char y, unsigned char x0, unsigned char x1) {
+    fog_set_span(fog_plane + (unsigned short)y * fog_stride, x0, x1);
+}
+
+void fog_reveal_rect(unsigned char x, unsigned char y, unsigned char w, unsigned char h) {
+    if (x >= current_params.map_width || y >= current_params.map_height || !w || !h) return;
+
+    // Clip right and bottom edges to map
+    unsigned char x1 = x + w - 1;
+    unsigned char y1 = y + h - 1;
+    if (x1 >= current_params.map_width) x1 = current_params.map_width - 1;
+    if (y1 >= current_params.map_height) y1 = current_params.map_height - 1;
+
+    for (unsigned char ry = y; ry <= y1; ry++) {
+        fog_reveal_span(ry, x, x1);
+    }
+}
+
+unsigned char fog_reveal_room(unsigned char room_id) {
+    if (room_id >= room_count || fog_room_revealed(room_id)) return 0;
+
+    Room *room = &room_list[room_id];
+    fog_room_seen[room_id >> 3] |= fog_bit_mask[room_id & 7];
+
+    // Rooms never touch the map edge (MAP_BORDER), so walls are in bounds
+    fog_reveal_rect(room->x - 1, room->y - 1, room->w + 2, room->h + 2);
+    return 1;
+}
+
+void fog_reveal_radius(unsigned char cx, unsigned char cy, unsigned char radius) {
+    if (radius > FOG_MAX_RADIUS) radius = FOG_MAX_RADIUS;
+
+    for (unsigned char dy = 0; dy <= radius; dy++) {
+        unsigned char half = fog_radius_span[radius][dy];
+        unsigned char x0 = (cx > half) ? cx - half : 0;
+        unsigned char x1 = cx + half;
+        if (x1 >= current_params.map_width) x1 = current_params.map_width - 1;
+
+        if (cy >= dy) {
+            fog_reveal_span(cy - dy, x0, x1);
+        }
+        if (dy && cy + dy < current_params.map_height) {
+            fog_reveal_span(cy + dy, x0, x1);
+        }
+    }
+}
+
+void fog_update_player(unsigned char x, unsigned char y) {
+    unsigned char region = region_at(x, y);
+
+    if (region_is_room(region)) {
+        fog_reveal_room(region);
+    } else {
+        fog_reveal_radius(x, y, FOG_CORRIDOR_RADIUS);
+    }
+}
+
+// =============================================================================
+// QUERY FUNCTIONS
+// =============================================================================
+
+unsigned char fog_is_revealed(unsigned char x, unsigned char y) {
+    if (x >= current_params.map_width || y >= current_params.map_height) return 0;
+    return fog_row_ptr(y)[x >> 3] & fog_bit_mask[x & 7];
+}
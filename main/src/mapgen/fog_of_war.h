@@ -0,0 +1,171 @@
+#ifndef FOG_OF_WAR_H
+#define FOG_OF_WAR_H
+
+// =============================================================================
+// FOG OF WAR - Explored Tile Bitplane
+// =============================================================================
+//
+// One bit per map tile, set once the player has seen the tile.
+// Rows are padded to whole bytes; the row stride is taken from
+// current_params.map_width so SMALL maps use a smaller part of the plane.
+//
+// Bit layout (matches compact_map LSB-first packing):
+// - Byte index:  y * fog_stride + (x >> 3)
+// - Bit index:   x & 7 (bit 0 = leftmost tile of the byte)
+//
+// Reveal strategies:
+// - Rooms: whole rectangle (including walls) at once via byte-masked
+//   span ORs - one OR per partial byte, one store per full byte
+// - Corridors: small radius around the player (no room to reveal)
+//
+// Renderer integration:
+// - fog_row_ptr(y) returns the row base once per screen row
+// - fog_bit_mask[x & 7] tests a tile with a single AND
+//
+// Persistence: the used part of the plane is contiguous
+// (fog_plane_bytes bytes from fog_plane), so saving is a block copy.
+//
+// Memory: 800 bytes plane + 3 bytes (80x80 maximum)
+//
+// =============================================================================
+
+#include "mapgen_types.h"
+
+// Fog plane dimensions
+enum FogConstants {
+    FOG_MAX_STRIDE = (MAX_MAP_SIZE + 7) / 8,            // 10 bytes per row
+    FOG_PLANE_SIZE = FOG_MAX_STRIDE * MAX_MAP_SIZE,     // 800 bytes
+    FOG_ROOM_MASK_SIZE = (MAX_ROOMS + 7) / 8,           // Revealed-room bitset
+    FOG_CORRIDOR_RADIUS = 3,                            // Corridor reveal radius
+    FOG_MAX_RADIUS = 5                                  // Largest radius in span table
+};
+
+// =============================================================================
+// GLOBAL STATE DECLARATIONS
+// =============================================================================
+
+extern unsigned char fog_plane[FOG_PLANE_SIZE];                 // 800 bytes
+extern unsigned char fog_room_seen[FOG_ROOM_MASK_SIZE];         // 4 bytes
+extern unsigned char fog_stride;                                // Bytes per row
+extern unsigned short fog_plane_bytes;                          // Used bytes
+
+// Bit mask tables indexed by (x & 7) - shared with other bitset modules
+extern const unsigned char fog_bit_mask[8];         // Single bit
+extern const unsigned char fog_mask_from[8];        // Bit (x & 7) up to bit 7
+extern const unsigned char fog_mask_to[8];          // Bit 0 up to bit (x & 7)
+
+// Circle half-width per row offset, index: [radius][abs(dy)]
+extern const unsigned char fog_radius_span[FOG_MAX_RADIUS + 1][FOG_MAX_RADIUS + 1];
+
+// =============================================================================
+// INITIALIZATION
+// =============================================================================
+
+/**
+ * @brief Clear fog plane and size it from current_params
+ *
+ * Must be called after current_params is set for a new map.
+ *
+ * Performance: ~800 cycles per 100 bytes cleared
+ */
+void fog_init(void);
+
+// =============================================================================
+// REVEAL FUNCTIONS
+// =============================================================================
+
+/**
+ * @brief Set bits x0..x1 of a bit row (fog plane row or FOV window row)
+ * @param row Row base
+ * @param x0 First bit (inclusive)
+ * @param x1 Last bit (inclusive, x1 >= x0)
+ *
+ * Partial bytes at both ends are ORed with precomputed masks,
+ * full bytes in between are stored as 0xFF.
+ *
+ * Performance: ~50 cycles + ~10 cycles per full byte
+ */
+void fog_set_span(unsigned char *row, unsigned char x0, unsigned char x1);
+
+/**
+ * @brief Mark a horizontal run of tiles as explored
+ * @param y Row
+ * @param x0 First column (inclusive)
+ * @param x1 Last column (inclusive, x1 >= x0)
+ *
+ * Performance: ~60 cycles + ~10 cycles per full byte
+ */
+void fog_reveal_span(unsigned char y, unsigned char x0, unsigned char x1);
+
+/**
+ * @brief Mark a rectangle of tiles as explored (clipped to map)
+ * @param x Left column
+ * @param y Top row
+ * @param w Width in tiles
+ * @param h Height in tiles
+ */
+void fog_reveal_rect(unsigned char x, unsigned char y, unsigned char w, unsigned char h);
+
+/**
+ * @brief Reveal a whole room including its walls
+ * @param room_id Room index
+ * @return 1 if room was newly revealed, 0 if already explored or invalid
+ *
+ * Performance: ~700 cycles for an 8x8 room (10 spans), ~30 cycles if seen
+ */
+unsigned char fog_reveal_room(unsigned char room_id);
+
+/**
+ * @brief Reveal a roughly circular area around a point
+ * @param cx Center X
+ * @param cy Center Y
+ * @param radius Reveal radius (clamped to FOG_MAX_RADIUS)
+ *
+ * Used for corridors where there is no room rectangle to reveal.
+ */
+void fog_reveal_radius(unsigned char cx, unsigned char cy, unsigned char radius);
+
+/**
+ * @brief Update fog for a player standing at (x, y)
+ * @param x Player X
+ * @param y Player Y
+ *
+ * Inside a room: reveals the whole room (once).
+ * Elsewhere: reveals FOG_CORRIDOR_RADIUS around the player.
+ */
+void fog_update_player(unsigned char x, unsigned char y);
+
+// =============================================================================
+// QUERY FUNCTIONS
+// =============================================================================
+
+/**
+ * @brief Check if tile has been explored
+ * @param x Tile X
+ * @param y Tile Y
+ * @return Non-zero if explored, 0 otherwise (or out of bounds)
+ */
+unsigned char fog_is_revealed(unsigned char x, unsigned char y);
+
+/**
+ * @brief Get pointer to the fog bits of a map row
+ * @param y Row (must be < map_height)
+ * @return Pointer to fog_stride bytes for that row
+ *
+ * Renderer usage: fetch once per row, then per tile
+ *   if (row[x >> 3] & fog_bit_mask[x & 7]) draw tile; else draw EMPTY;
+ */
+static inline const unsigned char *fog_row_ptr(unsigned char y) {
+    return fog_plane + (unsigned short)y * fog_stride;
+}
+
+/**
+ * @brief Check if room has already been revealed
+ * @param room_id Room index
+ * @return Non-zero if revealed
+ */
+static inline unsigned char fog_room_revealed(unsigned char room_id) {
+    return fog_room_seen[room_id >> 3] & fog_bit_mask[room_id & 7];
+}
+
+#endif // FOG_OF_WAR_H
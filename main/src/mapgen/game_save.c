@@ -0,0 +1,275 @@
+// =============================================================================
+// GAME SAVE - Block-Transfer Save/Load of the Full Game State
+// Implementation - Oscar64 Optimized
+// =============================================================================
+
+#include <string.h>
+#include <c64/kernalio.h>
+#include <c64/memmap.h>
+#include "game_save.h"
+#include "level_cache.h"
+#include "level_journal.h"
+#include "lz_codec.h"
+#include "overlay_loader.h"
+#include "spawn_tables.h"
+#include "status_effects.h"
+#include "combat_tables.h"
+#include "tmea_core.h"
+#include "mapgen_api.h"
+
+// Staging area: top of the RAM under BASIC
+#ifdef LEVEL_CACHE_UNDER_KERNAL
+#define SAVE_STAGE_BASE     ((unsigned char *)0xA000)   // Not used by the cache
+#define SAVE_STAGE_SIZE     0x2000
+#define save_stage_used()   0
+#define save_stage_claim()  (overlay_park_size = 0)    // Drops a parked overlay
+#else
+#define SAVE_STAGE_BASE     LEVEL_CACHE_BASE            // Shared with the cache
+#define SAVE_STAGE_SIZE     LEVEL_CACHE_SIZE
+#define save_stage_used()   level_cache_used
+#define save_stage_claim()
+#endif
+#define SAVE_STAGE_END      (SAVE_STAGE_BASE + SAVE_STAGE_SIZE)
+
+// =============================================================================
+// GLOBAL STATE DEFINITIONS
+// =============================================================================
+
+// Game settings not kept in any other block
+typedef struct {
+    unsigned int seed;
+    unsigned char depth;                // spawn_depth (255 = tables not built)
+} SaveInfo;
+
+static SaveInfo save_info;                                  // 3 bytes
+static SaveTrailer save_trailer;                            // 9 bytes
+static char save_command[SAVE_NAME_MAX + 5];                // 21 bytes - "S0:" + name, name + ",P,R"
+
+// Image writer state
+static unsigned char *save_out;
+static unsigned int save_out_len, save_out_max;
+static unsigned char save_flags;
+
+// =============================================================================
+// LOOKUP TABLES (ROM)
+// =============================================================================
+
+// Game part of the image; the used part of journal_store follows
+static const CacheBlock save_fixed_blocks[] = {
+    { &save_info,               sizeof(save_info) },
+    { &status_active,           sizeof(status_active) },
+    { &player_status_timers,    sizeof(player_status_timers) },
+    { &combat_loadout,          sizeof(combat_loadout) },
+    { &journal_store_used,      sizeof(journal_store_used) },
+    { journal_level_len,        sizeof(journal_level_len) },
+    { journal_level_ofs,        sizeof(journal_level_ofs) }
+};
+
+enum GameSaveBlocks {
+    SAVE_FIXED_BLOCKS = sizeof(save_fixed_blocks) / sizeof(CacheBlock)
+};
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+// Game block walker (same contract as level_snapshot_block)
+static unsigned char save_game_block(unsigned char index, CacheBlock *block) {
+    if (index < SAVE_FIXED_BLOCKS) {
+        *block = save_fixed_blocks[index];
+        return 1;
+    }
+    if (index > SAVE_FIXED_BLOCKS) return 0;
+
+    block->ptr = journal_store;
+    block->size = journal_store_used;
+    return 1;
+}
+
+static unsigned char save_put_block(const CacheBlock *block) {
+    if (!block->size) return 1;
+
+    unsigned int n;
+    if (save_flags & SAVE_COMPRESSED) {
+        n = lz_compress((const unsigned char *)block->ptr, block->size,
+                        save_out + save_out_len, save_out_max - save_out_len);
+        if (!n) return 0;
+    } else {
+        n = block->size;
+        if (n > save_out_max - save_out_len) return 0;
+        memcpy(save_out + save_out_len, block->ptr, n);
+    }
+    save_out_len += n;
+    return 1;
+}
+
+static const unsigned char *save_get_block(const CacheBlock *block, const unsigned char *src) {
+    if (!block->size) return src;
+
+    if (save_flags & SAVE_COMPRESSED) {
+        return src + lz_decompress(src, (unsigned char *)block->ptr, block->size);
+    }
+    memcpy(block->ptr, src, block->size);
+    return src + block->size;
+}
+
+// Write all blocks behind the used cache area; returns 0 if they do not fit
+static unsigned char save_pack(void) {
+    CacheBlock block;
+
+    save_out = SAVE_STAGE_BASE + save_stage_used();
+    save_out_len = 0;
+    save_out_max = SAVE_STAGE_SIZE - save_stage_used() - sizeof(SaveTrailer);
+
+    for (unsigned char i = 0; save_game_block(i, &block); i++) {
+        if (!save_put_block(&block)) return 0;
+    }
+    for (unsigned char i = 0; level_snapshot_block(i, &block); i++) {
+        if (!save_put_block(&block)) return 0;
+    }
+    return 1;
+}
+
+// Fletcher-style check: two running 8-bit sums, order sensitive
+static unsigned int save_checksum(const unsigned char *data, unsigned int len) {
+    unsigned char sum1 = 0, sum2 = 0;
+    while (len--) {
+        sum1 += *data++;
+        sum2 += sum1;
+    }
+    return sum1 | ((unsigned int)sum2 << 8);
+}
+
+// KERNAL SAVE does not overwrite: scratch the old file first
+static void save_scratch(const char *filename) {
+    unsigned char n = 3;
+    save_command[0] = 'S';
+    save_command[1] = '0';
+    save_command[2] = ':';
+    while (*filename && n < SAVE_NAME_MAX + 3) save_command[n++] = *filename++;
+    save_command[n] = 0;
+
+    krnio_setnam(save_command);
+    if (krnio_open(15, SAVE_DEVICE, 15)) krnio_close(15);
+}
+
+// Read the file into the stage, then move it up against the end of the
+// area (trailer at a fixed spot). Only the stage is written: a file
+// that does not fit is rejected once the stage is full.
+// Returns the bytes read (0 on failure).
+static unsigned int save_read_image(const char *filename) {
+    unsigned char n = 0;
+    while (*filename && n < SAVE_NAME_MAX) save_command[n++] = *filename++;
+    save_command[n++] = ',';
+    save_command[n++] = 'P';
+    save_command[n++] = ',';
+    save_command[n++] = 'R';
+    save_command[n] = 0;
+
+    krnio_setnam(save_command);
+    if (!krnio_open(2, SAVE_DEVICE, 2)) return 0;
+
+    // Skip the load address (into the trailer, read again from the
+    // image below), the file goes to the stage in any case
+    unsigned int size = 0;
+    unsigned char ok = krnio_read(2, (char *)&save_trailer, 2) == 2;
+
+    if (ok) {
+        int r;
+        while (size < SAVE_STAGE_SIZE &&
+               (r = krnio_read(2, (char *)SAVE_STAGE_BASE + size, SAVE_STAGE_SIZE - size)) > 0) {
+            size += r;
+        }
+
+        // Fits only if the file ended inside the stage
+        if (size == SAVE_STAGE_SIZE && krnio_read(2, (char *)&save_trailer, 1) > 0) ok = 0;
+        if (size < sizeof(SaveTrailer)) ok = 0;
+    }
+    krnio_close(2);
+
+    if (ok) {
+        char config = mmap_set(MMAP_NO_BASIC);
+        memmove(SAVE_STAGE_END - size, SAVE_STAGE_BASE, size);
+        mmap_set(config);
+    }
+    return ok ? size : 0;
+}
+
+// =============================================================================
+// SAVE FUNCTIONS
+// =============================================================================
+
+unsigned char game_save(const char *filename, unsigned char flags) {
+    save_info.seed = mapgen_get_seed();
+    save_info.depth = spawn_depth;
+    save_flags = flags;
+    save_stage_claim();
+
+    // Make room in the cache RAM, least recently used levels first
+    while (!save_pack()) {
+        if (!save_stage_used() || !level_cache_evict()) return 0;
+    }
+
+    char config = mmap_set(MMAP_NO_BASIC);
+
+    save_trailer.magic[0] = SAVE_MAGIC_0;
+    save_trailer.magic[1] = SAVE_MAGIC_1;
+    save_trailer.version = SAVE_VERSION;
+    save_trailer.flags = flags;
+    save_trailer.build = SAVE_BUILD;
+    save_trailer.length = save_out_len;
+    save_trailer.checksum = save_checksum(save_out, save_out_len);
+    memcpy(save_out + save_out_len, &save_trailer, sizeof(SaveTrailer));
+
+    // Move the image up against the end of the area (trailer at a fixed spot)
+    unsigned int size = save_out_len + sizeof(SaveTrailer);
+    unsigned char *image = SAVE_STAGE_END - size;
+    memmove(image, save_out, size);
+
+    save_scratch(filename);
+    krnio_setnam(filename);
+    unsigned char ok = krnio_save(SAVE_DEVICE, (const char *)image, (const char *)SAVE_STAGE_END);
+
+    mmap_set(config);
+    return ok;
+}
+
+unsigned char game_load(const char *filename) {
+    level_cache_init();
+    save_stage_claim();
+
+    unsigned int size = save_read_image(filename);
+    if (!size) return 0;
+
+    char config = mmap_set(MMAP_NO_BASIC);
+
+    memcpy(&save_trailer, SAVE_STAGE_END - sizeof(SaveTrailer), sizeof(SaveTrailer));
+    const unsigned char *src = SAVE_STAGE_END - sizeof(SaveTrailer) - save_trailer.length;
+
+    unsigned char ok = save_trailer.magic[0] == SAVE_MAGIC_0 &&
+                       save_trailer.magic[1] == SAVE_MAGIC_1 &&
+                       save_trailer.version == SAVE_VERSION &&
+                       save_trailer.build == SAVE_BUILD &&
+                       save_trailer.length + sizeof(SaveTrailer) == size &&
+                       save_checksum(src, save_trailer.length) == save_trailer.checksum;
+
+    if (ok) {
+        CacheBlock block;
+        save_flags = save_trailer.flags;
+
+        for (unsigned char i = 0; save_game_block(i, &block); i++) {
+            src = save_get_block(&block, src);
+        }
+        mapgen_init(save_info.seed);
+        for (unsigned char i = 0; level_snapshot_block(i, &block); i++) {
+            src = save_get_block(&block, src);
+        }
+    }
+
+    mmap_set(config);
+    if (!ok) return 0;
+
+    if (save_info.depth <= SPAWN_MAX_DEPTH) spawn_set_depth(save_info.depth);
+    level_snapshot_rebuild();
+    return 1;
+}
@@ -0,0 +1,88 @@
+#ifndef GAME_SAVE_H
+#define GAME_SAVE_H
+
+// =============================================================================
+// GAME SAVE - Block-Transfer Save/Load of the Full Game State
+// =============================================================================
+//
+// One save file = one contiguous memory image, written with KERNAL SAVE
+// (block transfer, no per-byte CHROUT loop in our code) and read back
+// with krnio_read straight into the staging RAM. Drive speeders
+// accelerate both.
+//
+// Image contents (in order):
+// - Seed, dungeon depth
+// - Player: status_active, player_status_timers, combat_loadout
+// - Level journal: directory and used part of journal_store
+// - Current level snapshot (level_snapshot_block: map, rooms, TMEA
+//   pools, regions, fog, live journal log)
+// - Trailer: magic, version, flags, build mode, data length, checksum
+//
+// With SAVE_COMPRESSED every block goes through lz_codec: a MEDIUM level
+// save drops from ~4.5KB to ~2.5KB, which nearly halves the disk time.
+//
+// Staging: the image is built in the RAM under BASIC, ending at $BFFF,
+// in the space the level cache does not use (cache entries are evicted
+// least recently used first if needed). Loading reads the file into the
+// same area and moves it up to $BFFF, so the trailer is always found at
+// the top.
+//
+// Loading never writes outside the staging area (a file too large for
+// it is rejected) and checks the checksum before anything is
+// overwritten; a bad file leaves the game untouched (the level cache is
+// cleared, though).
+//
+// Performance: pack ~0.3s raw / ~0.8s compressed, disk time by size
+// Memory: ~40 bytes (trailer, scratch command, writer state)
+//
+// =============================================================================
+
+#define SAVE_MAGIC_0        'Q'
+#define SAVE_MAGIC_1        'S'
+#define SAVE_VERSION        2
+
+// Build mode byte: MAPGEN_LARGE_MAPS changes the map chunks, the
+// MAX_ROOMS sized blocks and the region span width, so a save only
+// loads in the build mode that wrote it
+#define SAVE_BUILD          MAX_ROOMS
+
+// Save flags
+#define SAVE_COMPRESSED     0x01        // Blocks LZ-compressed
+
+enum GameSaveConstants {
+    SAVE_DEVICE = 8,
+    SAVE_NAME_MAX = 16                  // Filename characters
+};
+
+// Image trailer (last 9 bytes of the file)
+typedef struct {
+    unsigned char magic[2];
+    unsigned char version;
+    unsigned char flags;                // SAVE_* flags
+    unsigned char build;                // SAVE_BUILD
+    unsigned int length;                // Data bytes before the trailer
+    unsigned int checksum;              // Fletcher-style sum of the data
+} SaveTrailer;
+
+// =============================================================================
+// SAVE FUNCTIONS
+// =============================================================================
+
+/**
+ * @brief Write the game to disk (replaces an existing file)
+ * @param filename PETSCII filename (max 16 chars)
+ * @param flags SAVE_* flags
+ * @return 1 on success, 0 if the image does not fit or the disk failed
+ */
+unsigned char game_save(const char *filename, unsigned char flags);
+
+/**
+ * @brief Read a game from disk and make it current
+ * @param filename PETSCII filename (max 16 chars)
+ * @return 1 on success, 0 if missing, damaged or not a save file
+ *
+ * Always empties the level cache (the file is loaded into its RAM).
+ */
+unsigned char game_load(const char *filename);
+
+#endif // GAME_SAVE_H
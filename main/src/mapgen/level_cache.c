@@ -0,0 +1,276 @@
+// =============================================================================
+// LEVEL CACHE - Compressed Recent Levels in RAM Under ROM
+// Implementation - Oscar64 Optimized
+// =============================================================================
+
+#include <string.h>
+#include <c64/memmap.h>
+#include "level_cache.h"
+#include "lz_codec.h"
+#include "level_journal.h"
+#include "fog_of_war.h"
+#include "region_map.h"
+#include "flow_field.h"
+#include "turn_scheduler.h"
+#include "status_effects.h"
+#include "combat_tables.h"
+#include "tmea_core.h"
+#include "mapgen_types.h"
+#include "mapgen_internal.h"
+#include "mapgen_utils.h"
+
+// =============================================================================
+// GLOBAL STATE DEFINITIONS
+// =============================================================================
+
+LevelCacheEntry level_cache_dir[LEVEL_CACHE_SLOTS];         // 40 bytes
+unsigned char level_cache_count;                            // 1 byte
+unsigned int level_cache_used;                              // 2 bytes
+
+// =============================================================================
+// LOOKUP TABLES (ROM)
+// =============================================================================
+
+// Fixed-size level state. Restored first: the counts in here give the
+// sizes of the variable blocks (cache_variable_blocks).
+static const CacheBlock cache_fixed_blocks[] = {
+    { &current_params,          sizeof(current_params) },
+    { &room_count,              1 },
+    { room_meta_count,          sizeof(room_meta_count) },
+    { room_metas,               sizeof(room_metas) },
+    { &global_meta_count,       1 },
+    { &obj_free_list,           sizeof(obj_free_list) },
+    { &obj_active_list,         sizeof(obj_active_list) },
+    { obj_pool,                 sizeof(obj_pool) },
+    { &mon_free_list,           sizeof(mon_free_list) },
+    { &mon_active_list,         sizeof(mon_active_list) },
+    { mon_pool,                 sizeof(mon_pool) },
+    { boss_ai_state,            sizeof(boss_ai_state) },
+    { &status_mon_active,       1 },
+    { status_mon_poison,        sizeof(status_mon_poison) },
+    { status_mon_stun,          sizeof(status_mon_stun) },
+    { region_row_head,          sizeof(region_row_head) },
+    { region_col_head,          sizeof(region_col_head) },
+    { &region_span_count,       sizeof(region_span_count) },
+    { &region_corridor_count,   1 },
+    { region_corridor_room_a,   sizeof(region_corridor_room_a) },
+    { region_corridor_room_b,   sizeof(region_corridor_room_b) },
+    { fog_room_seen,            sizeof(fog_room_seen) },
+    { &fog_stride,              1 },
+    { &fog_plane_bytes,         sizeof(fog_plane_bytes) },
+    { &journal_log_len,         1 },
+    { &stairs_up_room,          1 },
+    { &stairs_down_room,        1 },
+    { &total_connections,       1 },
+    { &total_hidden_rooms,      1 },
+    { &total_niches,            1 },
+    { &total_decoys,            1 },
+    { &available_walls_count,   1 }
+};
+
+enum LevelCacheBlocks {
+    CACHE_FIXED_BLOCKS = sizeof(cache_fixed_blocks) / sizeof(CacheBlock),
+    CACHE_VARIABLE_BLOCKS = 5
+};
+
+// Variable blocks of the current level (used part of each array only)
+static CacheBlock cache_var[CACHE_VARIABLE_BLOCKS];         // 20 bytes
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+// Make the cache RAM readable; returns the previous memory configuration
+static inline char cache_bank_in(void) {
+#ifdef LEVEL_CACHE_UNDER_KERNAL
+    __asm { sei }
+    return mmap_set(MMAP_NO_ROM);
+#else
+    return mmap_set(MMAP_NO_BASIC);
+#endif
+}
+
+static inline void cache_bank_out(char config) {
+    mmap_set(config);
+#ifdef LEVEL_CACHE_UNDER_KERNAL
+    __asm { cli }
+#endif
+}
+
+static void cache_variable_blocks(void) {
+    cache_var[0].ptr = room_list;
+    cache_var[0].size = room_count * sizeof(Room);
+    cache_var[1].ptr = global_metas;
+    cache_var[1].size = global_meta_count * sizeof(GlobalTileMeta);
+    cache_var[2].ptr = region_spans;
+    cache_var[2].size = region_span_count * sizeof(RegionSpan);
+    cache_var[3].ptr = fog_plane;
+    cache_var[3].size = fog_plane_bytes;
+    cache_var[4].ptr = journal_log;
+    cache_var[4].size = journal_log_len;
+}
+
+// Compress one block behind *out; returns 0 if the cache is full
+static unsigned char cache_pack(const CacheBlock *block, unsigned int *out) {
+    if (!block->size) return 1;
+    unsigned int n = lz_compress((const unsigned char *)block->ptr, block->size,
+                                 LEVEL_CACHE_BASE + *out, LEVEL_CACHE_SIZE - *out);
+    *out += n;
+    return n != 0;
+}
+
+// Compress the whole level behind the used area; returns size or 0
+static unsigned int cache_pack_level(void) {
+    unsigned int out = level_cache_used;
+    CacheBlock block;
+
+    for (unsigned char i = 0; level_snapshot_block(i, &block); i++) {
+        if (!cache_pack(&block, &out)) return 0;
+    }
+    return out - level_cache_used;
+}
+
+static unsigned char cache_find(unsigned char level) {
+    for (unsigned char i = 0; i < level_cache_count; i++) {
+        if (level_cache_dir[i].level == level) return i;
+    }
+    return LEVEL_CACHE_SLOTS;
+}
+
+// Drop a directory entry and close its gap in the cache area
+static void cache_remove(unsigned char index) {
+    unsigned int ofs = level_cache_dir[index].offset;
+    unsigned int size = level_cache_dir[index].size;
+
+    char config = cache_bank_in();
+    memmove(LEVEL_CACHE_BASE + ofs, LEVEL_CACHE_BASE + ofs + size, level_cache_used - ofs - size);
+    cache_bank_out(config);
+    level_cache_used -= size;
+
+    level_cache_count--;
+    for (unsigned char i = index; i < level_cache_count; i++) {
+        level_cache_dir[i] = level_cache_dir[i + 1];
+    }
+    for (unsigned char i = 0; i < level_cache_count; i++) {
+        if (level_cache_dir[i].offset > ofs) level_cache_dir[i].offset -= size;
+    }
+}
+
+// Move an entry to the front (most recently used)
+static void cache_touch(unsigned char index) {
+    LevelCacheEntry entry = level_cache_dir[index];
+    while (index > 0) {
+        level_cache_dir[index] = level_cache_dir[index - 1];
+        index--;
+    }
+    level_cache_dir[0] = entry;
+}
+
+// =============================================================================
+// CACHE FUNCTIONS
+// =============================================================================
+
+void level_cache_init(void) {
+    level_cache_count = 0;
+    level_cache_used = 0;
+}
+
+unsigned char level_cache_store(unsigned char level) {
+    unsigned char index = cache_find(level);
+    if (index < LEVEL_CACHE_SLOTS) cache_remove(index);
+    if (level_cache_count == LEVEL_CACHE_SLOTS) cache_remove(level_cache_count - 1);
+
+    unsigned int size;
+    while (!(size = cache_pack_level())) {
+        if (!level_cache_count) return 0;
+        cache_remove(level_cache_count - 1);
+    }
+
+    index = level_cache_count++;
+    level_cache_dir[index].level = level;
+    level_cache_dir[index].offset = level_cache_used;
+    level_cache_dir[index].size = size;
+    level_cache_used += size;
+    cache_touch(index);
+    return 1;
+}
+
+unsigned char level_cache_load(unsigned char level) {
+    unsigned char index = cache_find(level);
+    if (index >= LEVEL_CACHE_SLOTS) return 0;
+
+    const unsigned char *src = LEVEL_CACHE_BASE + level_cache_dir[index].offset;
+    CacheBlock block;
+
+    char config = cache_bank_in();
+    for (unsigned char i = 0; level_snapshot_block(i, &block); i++) {
+        if (block.size) src += lz_decompress(src, (unsigned char *)block.ptr, block.size);
+    }
+    cache_bank_out(config);
+
+    cache_touch(index);
+    level_snapshot_rebuild();
+    return 1;
+}
+
+unsigned char level_cache_contains(unsigned char level) {
+    return cache_find(level) < LEVEL_CACHE_SLOTS;
+}
+
+unsigned char level_cache_evict(void) {
+    if (!level_cache_count) return 0;
+    cache_remove(level_cache_count - 1);
+    return 1;
+}
+
+// =============================================================================
+// SNAPSHOT LAYOUT
+// =============================================================================
+
+unsigned char level_snapshot_block(unsigned char index, CacheBlock *block) {
+    if (index < CACHE_FIXED_BLOCKS) {
+        *block = cache_fixed_blocks[index];
+        return 1;
+    }
+    index -= CACHE_FIXED_BLOCKS;
+
+    // Fixed blocks are all in place now: map storage first (one block,
+    // or one per chunk with MAPGEN_LARGE_MAPS), then the variable blocks
+    unsigned char map_chunks = map_chunk_count();
+    if (index < map_chunks) {
+        block->ptr = map_chunk_data(index, &block->size);
+        return 1;
+    }
+    index -= map_chunks;
+    if (index >= CACHE_VARIABLE_BLOCKS) return 0;
+
+    if (!index) cache_variable_blocks();
+    *block = cache_var[index];
+    return 1;
+}
+
+void level_snapshot_rebuild(void) {
+    level_enter(0);
+}
+
+// =============================================================================
+// LEVEL ENTRY
+// =============================================================================
+
+void level_enter(unsigned char fresh) {
+    // Runtime state a snapshot carries, a new level starts without
+    if (fresh) {
+        fog_init();
+        status_init();
+        journal_clear_log();
+    }
+
+    calculate_y_bit_stride();
+    measure_stair_walks(stairs_up_room, stairs_down_room);
+    flow_invalidate();
+    sched_init();
+    for (TinyMon *mon = mon_active_list; mon; mon = mon->next) {
+        sched_update_monster(mon);
+    }
+    combat_rebuild();
+}
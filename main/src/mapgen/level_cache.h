@@ -0,0 +1,154 @@
+#ifndef LEVEL_CACHE_H
+#define LEVEL_CACHE_H
+
+// =============================================================================
+// LEVEL CACHE - Compressed Recent Levels in RAM Under ROM
+// =============================================================================
+//
+// Going back up the stairs normally means a full regeneration plus
+// journal replay. The cache keeps the last few levels as LZ-compressed
+// snapshots (lz_codec) so a revisit is a decompress instead.
+//
+// Snapshot contents (exactly what a level consists of at runtime):
+// - current_params, compact_map, room_list
+// - TMEA metadata pools, object/monster pools and list heads
+// - Region map spans, fog plane, journal live log, stair rooms
+// Derived state (y_bit_stride, flow field, turn queue) is rebuilt after
+// a load. Player state (status timers, combat loadout) is not touched.
+//
+// Storage: 8KB of RAM hidden under the BASIC ROM ($A000-$BFFF) by
+// default; define LEVEL_CACHE_UNDER_KERNAL to use the RAM under the
+// KERNAL ($E000-$FFF9) instead (IRQs are masked during access). Writes
+// always reach the RAM; ROM is only banked out to read it back.
+//
+// Eviction: least recently used entry first (directory kept in MRU
+// order); entries are packed, the gap left by a removed one is closed.
+//
+// Typical snapshot: ~1.7KB small, ~2.4KB medium, ~3.7KB large map,
+// so 2-4 levels fit.
+//
+// Performance: store ~0.5s (compression), load ~0.1s
+// Memory: 8KB banked cache + 43 bytes directory
+//
+// =============================================================================
+
+#ifdef LEVEL_CACHE_UNDER_KERNAL
+#define LEVEL_CACHE_BASE    ((unsigned char *)0xE000)
+#define LEVEL_CACHE_SIZE    0x1FFA              // Up to the CPU vectors
+#else
+#ifndef LEVEL_CACHE_BASE
+#define LEVEL_CACHE_BASE    ((unsigned char *)0xA000)
+#define LEVEL_CACHE_SIZE    0x2000
+#endif
+#endif
+
+enum LevelCacheConstants {
+    LEVEL_CACHE_SLOTS = 8               // Directory entries
+};
+
+// Snapshot block (address and size of one piece of level state)
+typedef struct {
+    void *ptr;
+    unsigned int size;
+} CacheBlock;
+
+// Directory entry (5 bytes)
+typedef struct {
+    unsigned char level;                // Level number
+    unsigned int offset;                // Start in the cache area
+    unsigned int size;                  // Compressed bytes
+} LevelCacheEntry;
+
+// =============================================================================
+// GLOBAL STATE DECLARATIONS
+// =============================================================================
+
+extern LevelCacheEntry level_cache_dir[LEVEL_CACHE_SLOTS];  // MRU first
+extern unsigned char level_cache_count;                     // Entries in use
+extern unsigned int level_cache_used;                       // Bytes in use
+
+// =============================================================================
+// CACHE FUNCTIONS
+// =============================================================================
+
+/**
+ * @brief Empty the cache (new game)
+ */
+void level_cache_init(void);
+
+/**
+ * @brief Compress the current level into the cache
+ * @param level Level number (key)
+ * @return 1 on success, 0 if the snapshot does not fit even in an empty cache
+ *
+ * Replaces an older copy of the same level; evicts least recently used
+ * levels until the snapshot fits.
+ */
+unsigned char level_cache_store(unsigned char level);
+
+/**
+ * @brief Restore a cached level
+ * @param level Level number
+ * @return 1 if the level was cached and is now current, 0 if not cached
+ *
+ * On 0 the caller regenerates the level (and replays its journal).
+ */
+unsigned char level_cache_load(unsigned char level);
+
+/**
+ * @brief Check if a level is cached
+ * @param level Level number
+ * @return Non-zero if cached
+ */
+unsigned char level_cache_contains(unsigned char level);
+
+/**
+ * @brief Drop the least recently used level
+ * @return 1 if a level was evicted, 0 if the cache is empty
+ *
+ * Lets other users of the cache RAM (game_save staging) make room.
+ */
+unsigned char level_cache_evict(void);
+
+// =============================================================================
+// SNAPSHOT LAYOUT
+// =============================================================================
+
+/**
+ * @brief Get one block of the current level's snapshot
+ * @param index Block number, counting from 0
+ * @param block Output address and size
+ * @return 1 if the block exists, 0 past the last block
+ *
+ * Walk the blocks in order: the sizes of later blocks are taken from
+ * counts in earlier ones, so a restore must fill block i before asking
+ * for block i+1.
+ */
+unsigned char level_snapshot_block(unsigned char index, CacheBlock *block);
+
+/**
+ * @brief Rebuild derived state after all snapshot blocks were restored
+ *
+ * Same as level_enter(0).
+ */
+void level_snapshot_rebuild(void);
+
+// =============================================================================
+// LEVEL ENTRY
+// =============================================================================
+
+/**
+ * @brief Set up the game runtime state of the level just made current
+ * @param fresh 1 for a generated or pack-streamed level, 0 for a
+ *        restored snapshot
+ *
+ * A fresh level starts with clear fog, no status effects and an empty
+ * journal log (a snapshot brings its own). Every level gets the Y bit
+ * stride, stair walk lengths, flow field, turn queue (awake monsters
+ * re-queued) and combat tables rebuilt. The generator leaves all of
+ * this alone: call it after mapgen_generate_*() for the level the
+ * player enters.
+ */
+void level_enter(unsigned char fresh);
+
+#endif // LEVEL_CACHE_H
@@ -0,0 +1,331 @@
+// =============================================================================
+// LEVEL JOURNAL - Per-Level State Deltas for Quest Persistence
+// Implementation - Oscar64 Optimized
+// =============================================================================
+
+#include <stddef.h>  // For NULL
+#include <string.h>
+#include "level_journal.h"
+#include "fog_of_war.h"
+#include "region_map.h"
+#include "tmea_core.h"
+#include "tmea_types.h"
+#include "mapgen_types.h"
+#include "mapgen_internal.h"
+
+// =============================================================================
+// GLOBAL STATE DEFINITIONS
+// =============================================================================
+
+unsigned char journal_store[JOURNAL_STORE_SIZE];            // 512 bytes
+unsigned char journal_level_len[JOURNAL_MAX_LEVELS];        // 12 bytes
+unsigned int journal_level_ofs[JOURNAL_MAX_LEVELS];         // 24 bytes
+unsigned int journal_store_used;                            // 2 bytes
+
+unsigned char journal_log[JOURNAL_LOG_SIZE];                // 96 bytes
+unsigned char journal_log_len;                              // 1 byte
+
+// Record writer state
+static unsigned char *journal_out;
+static unsigned int journal_out_len, journal_out_max;
+static unsigned char journal_nibble;                        // Pending low nibble or 0xFF
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+// Size of an event entry from its opcode byte
+static unsigned char journal_op_size(unsigned char op) {
+    switch (op & 0xF0) {
+        case JOURNAL_OP_TAKE: return 4;
+        case JOURNAL_OP_DROP: return 5;
+        case JOURNAL_OP_KILL: return 1;
+        case JOURNAL_OP_DOOR: return 3;
+        default: return 1;
+    }
+}
+
+static unsigned char journal_log_append(const unsigned char *entry, unsigned char size) {
+    if (journal_log_len + size > JOURNAL_LOG_SIZE) return 0;
+    memcpy(journal_log + journal_log_len, entry, size);
+    journal_log_len += size;
+    return 1;
+}
+
+static void journal_put(unsigned char value) {
+    if (journal_out_len < journal_out_max) journal_out[journal_out_len] = value;
+    journal_out_len++;
+}
+
+static void journal_put_nibble(unsigned char value) {
+    if (journal_nibble == 0xFF) {
+        journal_nibble = value;
+    } else {
+        journal_put(journal_nibble | (value << 4));
+        journal_nibble = 0xFF;
+    }
+}
+
+// Run length as nibbles; long runs split by empty runs of the other state
+static void journal_put_run(unsigned char run) {
+    while (run > 15) {
+        journal_put_nibble(15);
+        journal_put_nibble(0);
+        run -= 15;
+    }
+    journal_put_nibble(run);
+}
+
+// Fog region index: rooms first, then corridors in drawing order
+static unsigned char journal_region_id(unsigned char index) {
+    return (index < room_count) ? index : REGION_CORRIDOR_BASE + (index - room_count);
+}
+
+static unsigned char journal_region_seen(unsigned char index) {
+    if (index < room_count) return fog_room_revealed(index) != 0;
+
+    RegionIter it;
+    unsigned char x, y;
+    region_iter_begin(&it, journal_region_id(index));
+    while (region_iter_next(&it, &x, &y)) {
+        if (fog_is_revealed(x, y)) return 1;
+    }
+    return 0;
+}
+
+static void journal_region_reveal(unsigned char index) {
+    if (index < room_count) {
+        fog_reveal_room(index);
+        return;
+    }
+
+    // Corridor tiles with their walls
+    RegionIter it;
+    unsigned char x, y;
+    region_iter_begin(&it, journal_region_id(index));
+    while (region_iter_next(&it, &x, &y)) {
+        fog_reveal_rect(x - 1, y - 1, 3, 3);
+    }
+}
+
+static void journal_put_door(unsigned char x, unsigned char y, unsigned char flags) {
+    if (!is_meta_type(flags, TMTYPE_DOOR)) return;
+    unsigned char state = 0;
+    if (flags & TMFLAG_DOOR_REVEALED) state |= JOURNAL_DOOR_REVEALED;
+    if (flags & TMFLAG_DOOR_OPEN) state |= JOURNAL_DOOR_OPEN;
+    if (!state) return;
+
+    journal_put(JOURNAL_OP_DOOR | state);
+    journal_put(x);
+    journal_put(y);
+}
+
+static void journal_put_doors(void) {
+    for (unsigned char r = 0; r < room_count; r++) {
+        for (unsigned char i = 0; i < room_meta_count[r]; i++) {
+            const RoomTileMeta *meta = &room_metas[r][i];
+            journal_put_door(room_list[r].x + unpack_local_x(meta->local_pos),
+                             room_list[r].y + unpack_local_y(meta->local_pos),
+                             meta->flags);
+        }
+    }
+    for (unsigned char i = 0; i < global_meta_count; i++) {
+        journal_put_door(global_metas[i].x, global_metas[i].y, global_metas[i].flags);
+    }
+}
+
+static void journal_put_fog(void) {
+    unsigned char count = room_count + region_corridor_count;
+    unsigned int start = journal_out_len;
+    unsigned char state = 0, run = 0;
+
+    journal_put(JOURNAL_OP_FOG);
+    journal_put(0);                     // Run byte count, patched below
+    journal_nibble = 0xFF;
+
+    for (unsigned char i = 0; i < count; i++) {
+        unsigned char seen = journal_region_seen(i);
+        if (seen != state) {
+            journal_put_run(run);
+            state = seen;
+            run = 0;
+        }
+        run++;
+    }
+    if (state) journal_put_run(run);    // Trailing unexplored run is implied
+
+    if (journal_out_len == start + 2 && journal_nibble == 0xFF) {
+        journal_out_len = start;        // Nothing explored: no fog entry
+        return;
+    }
+    if (journal_nibble != 0xFF) journal_put_nibble(0);
+    if (start + 1 < journal_out_max) {
+        journal_out[start + 1] = (unsigned char)(journal_out_len - start - 2);
+    }
+}
+
+static void journal_apply_fog(const unsigned char *runs, unsigned char bytes) {
+    unsigned char index = 0, state = 0;
+
+    for (unsigned char i = 0; i < bytes * 2; i++) {
+        unsigned char run = (i & 1) ? runs[i >> 1] >> 4 : runs[i >> 1] & 0x0F;
+        if (state) {
+            for (unsigned char r = 0; r < run; r++) journal_region_reveal(index + r);
+        }
+        index += run;
+        state ^= 1;
+    }
+}
+
+static void journal_apply_event(const unsigned char *entry) {
+    unsigned char op = entry[0] & 0xF0;
+
+    if (op == JOURNAL_OP_TAKE) {
+        for (TinyObj *obj = obj_active_list; obj; obj = obj->next) {
+            if (obj->x == entry[1] && obj->y == entry[2] && obj->type == entry[3]) {
+                despawn_object(obj);
+                break;
+            }
+        }
+    } else if (op == JOURNAL_OP_DROP) {
+        TinyObj *obj = spawn_object(entry[1], entry[2], entry[3]);
+        if (obj) obj->data = entry[4];
+    } else if (op == JOURNAL_OP_KILL) {
+        TinyMon *mon = &mon_pool[entry[0] & 0x0F];
+        if (mon->flags & MFLAG_ALIVE) despawn_monster(mon);
+    }
+}
+
+// Drop a level's record and close the gap
+static void journal_remove(unsigned char level) {
+    unsigned char len = journal_level_len[level];
+    if (!len) return;
+
+    unsigned int ofs = journal_level_ofs[level];
+    memmove(journal_store + ofs, journal_store + ofs + len, journal_store_used - ofs - len);
+    journal_store_used -= len;
+    journal_level_len[level] = 0;
+
+    for (unsigned char i = 0; i < JOURNAL_MAX_LEVELS; i++) {
+        if (journal_level_len[i] && journal_level_ofs[i] > ofs) journal_level_ofs[i] -= len;
+    }
+}
+
+// Write the current level's record at the end of the store
+static unsigned char journal_build(void) {
+    journal_out = journal_store + journal_store_used;
+    journal_out_len = 0;
+    journal_out_max = JOURNAL_STORE_SIZE - journal_store_used;
+
+    for (unsigned char i = 0; i < journal_log_len; i++) journal_put(journal_log[i]);
+    journal_put_doors();
+    journal_put_fog();
+    journal_put(JOURNAL_OP_END);
+
+    // Records are limited to 255 bytes by journal_level_len
+    return (journal_out_len <= journal_out_max && journal_out_len < 256);
+}
+
+// =============================================================================
+// SETUP FUNCTIONS
+// =============================================================================
+
+void journal_init(void) {
+    for (unsigned char i = 0; i < JOURNAL_MAX_LEVELS; i++) {
+        journal_level_len[i] = 0;
+        journal_level_ofs[i] = 0;
+    }
+    journal_store_used = 0;
+    journal_log_len = 0;
+}
+
+void journal_clear_log(void) {
+    journal_log_len = 0;
+}
+
+// =============================================================================
+// RECORDING FUNCTIONS
+// =============================================================================
+
+unsigned char journal_item_taken(const TinyObj *obj) {
+    // Picking up an item dropped earlier cancels the drop
+    unsigned char i = 0;
+    while (i < journal_log_len) {
+        unsigned char size = journal_op_size(journal_log[i]);
+        if ((journal_log[i] & 0xF0) == JOURNAL_OP_DROP && journal_log[i + 1] == obj->x &&
+            journal_log[i + 2] == obj->y && journal_log[i + 3] == obj->type) {
+            memmove(journal_log + i, journal_log + i + size, journal_log_len - i - size);
+            journal_log_len -= size;
+            return 1;
+        }
+        i += size;
+    }
+
+    unsigned char entry[4] = { JOURNAL_OP_TAKE, obj->x, obj->y, obj->type };
+    return journal_log_append(entry, 4);
+}
+
+unsigned char journal_item_dropped(const TinyObj *obj) {
+    unsigned char entry[5] = { JOURNAL_OP_DROP, obj->x, obj->y, obj->type, obj->data };
+    return journal_log_append(entry, 5);
+}
+
+unsigned char journal_monster_killed(const TinyMon *mon) {
+    unsigned char entry = JOURNAL_OP_KILL | (unsigned char)(mon - mon_pool);
+    return journal_log_append(&entry, 1);
+}
+
+// =============================================================================
+// LEVEL FUNCTIONS
+// =============================================================================
+
+unsigned char journal_store_level(unsigned char level) {
+    if (level >= JOURNAL_MAX_LEVELS) return 0;
+
+    // Try without touching the old record first, so a full store keeps it
+    if (!journal_build()) {
+        if (!journal_level_len[level]) return 0;
+        journal_remove(level);
+        if (!journal_build()) return 0;
+    } else if (journal_level_len[level]) {
+        // Count the new record as used so removal shifts it down too
+        journal_store_used += journal_out_len;
+        journal_remove(level);
+        journal_store_used -= journal_out_len;
+    }
+
+    journal_level_ofs[level] = journal_store_used;
+    journal_level_len[level] = (unsigned char)journal_out_len;
+    journal_store_used += journal_out_len;
+    return 1;
+}
+
+unsigned char journal_restore_level(unsigned char level) {
+    if (!journal_level_visited(level)) return 0;
+
+    const unsigned char *p = journal_store + journal_level_ofs[level];
+    const unsigned char *end = p + journal_level_len[level];
+
+    journal_log_len = 0;
+    while (p < end) {
+        unsigned char op = *p & 0xF0;
+
+        if (op == JOURNAL_OP_END) break;
+        if (op == JOURNAL_OP_FOG) {
+            journal_apply_fog(p + 2, p[1]);
+            p += 2 + p[1];
+            continue;
+        }
+
+        unsigned char size = journal_op_size(*p);
+        if (op == JOURNAL_OP_DOOR) {
+            if (*p & JOURNAL_DOOR_REVEALED) reveal_secret_door(p[1], p[2]);
+            if (*p & JOURNAL_DOOR_OPEN) set_door_open(p[1], p[2], 1);
+        } else {
+            journal_apply_event(p);
+            journal_log_append(p, size);
+        }
+        p += size;
+    }
+    return 1;
+}
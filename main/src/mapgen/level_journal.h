@@ -0,0 +1,143 @@
+#ifndef LEVEL_JOURNAL_H
+#define LEVEL_JOURNAL_H
+
+// =============================================================================
+// LEVEL JOURNAL - Per-Level State Deltas for Quest Persistence
+// =============================================================================
+//
+// A level is regenerated from its seed, so only what the player changed
+// needs to be kept - not the full LevelState of the architecture plan
+// (1,135 bytes per level).
+//
+// Recorded while playing (journal_item_* / journal_monster_killed):
+// - Item taken / dropped, monster killed (baseline mon_pool slot)
+// - A drop picked up again cancels out of the log
+//
+// Captured at journal_store_level() from current state:
+// - Doors opened and secret doors revealed (TMEA door metadata flags)
+// - Fog as a room/corridor reveal set: one bit per region, stored as
+//   nibble run lengths (unexplored level: 0 bytes, fully explored: 1)
+//
+// Record format (byte stream, one per level):
+// - JOURNAL_OP_TAKE x y type           4 bytes
+// - JOURNAL_OP_DROP x y type data      5 bytes
+// - JOURNAL_OP_KILL | slot             1 byte
+// - JOURNAL_OP_DOOR | state, x y       3 bytes
+// - JOURNAL_OP_FOG  n runs[n]          2 + n bytes
+// - JOURNAL_OP_END                     1 byte (marks level visited)
+//
+// Restore: regenerate the level (same seed/depth), then
+// journal_restore_level() applies the record in one pass.
+//
+// Typical level: 20-60 bytes, so 12 Quest levels fit the 512-byte store.
+//
+// Memory: 512 bytes store + 96 bytes live log + 14 bytes
+//
+// =============================================================================
+
+#include "tmea_types.h"
+
+enum JournalConstants {
+    JOURNAL_MAX_LEVELS = 12,            // Quest mode depth
+    JOURNAL_STORE_SIZE = 512,           // Records of all levels
+    JOURNAL_LOG_SIZE = 96               // Live events of current level
+};
+
+// Record opcodes (high nibble)
+#define JOURNAL_OP_END      0x00
+#define JOURNAL_OP_TAKE     0x10
+#define JOURNAL_OP_DROP     0x20
+#define JOURNAL_OP_KILL     0x30        // Low nibble = mon_pool slot
+#define JOURNAL_OP_DOOR     0x40
+#define JOURNAL_OP_FOG      0x50
+
+// JOURNAL_OP_DOOR low nibble
+#define JOURNAL_DOOR_REVEALED   0x01    // TMFLAG_DOOR_REVEALED
+#define JOURNAL_DOOR_OPEN       0x02    // TMFLAG_DOOR_OPEN
+
+// =============================================================================
+// GLOBAL STATE DECLARATIONS
+// =============================================================================
+
+// Stored records, level after level (contiguous for block save)
+extern unsigned char journal_store[JOURNAL_STORE_SIZE];     // 512 bytes
+extern unsigned char journal_level_len[JOURNAL_MAX_LEVELS]; // 0 = never visited
+extern unsigned int journal_level_ofs[JOURNAL_MAX_LEVELS];  // Record start in store
+extern unsigned int journal_store_used;                     // Bytes in use
+
+// Live event log of the current level (part of level cache snapshots)
+extern unsigned char journal_log[JOURNAL_LOG_SIZE];         // 96 bytes
+extern unsigned char journal_log_len;
+
+// =============================================================================
+// SETUP FUNCTIONS
+// =============================================================================
+
+/**
+ * @brief Forget all levels (new game)
+ */
+void journal_init(void);
+
+/**
+ * @brief Clear the live log of the current level
+ */
+void journal_clear_log(void);
+
+// =============================================================================
+// RECORDING FUNCTIONS
+// =============================================================================
+
+/**
+ * @brief Record an item picked up (call before despawn_object)
+ * @param obj Object leaving the map
+ * @return 1 on success, 0 if the log is full
+ */
+unsigned char journal_item_taken(const TinyObj *obj);
+
+/**
+ * @brief Record an item dropped on the map
+ * @param obj Object after spawn_object() and data setup
+ * @return 1 on success, 0 if the log is full
+ */
+unsigned char journal_item_dropped(const TinyObj *obj);
+
+/**
+ * @brief Record a monster killed (call before despawn_monster)
+ * @param mon Monster from mon_pool
+ * @return 1 on success, 0 if the log is full
+ */
+unsigned char journal_monster_killed(const TinyMon *mon);
+
+// =============================================================================
+// LEVEL FUNCTIONS
+// =============================================================================
+
+/**
+ * @brief Save the delta of the current level (before leaving it)
+ * @param level Level index (0 .. JOURNAL_MAX_LEVELS-1)
+ * @return 1 on success, 0 if invalid or the store is full
+ *
+ * Replaces any older record of the same level.
+ */
+unsigned char journal_store_level(unsigned char level);
+
+/**
+ * @brief Apply a stored delta to the freshly regenerated level
+ * @param level Level index
+ * @return 1 if a record was applied, 0 if the level was never stored
+ *
+ * Call right after mapgen_generate_with_params() for the level. The
+ * recorded events become the live log again, so further changes append.
+ */
+unsigned char journal_restore_level(unsigned char level);
+
+/**
+ * @brief Check if a level has a stored record
+ * @param level Level index
+ * @return Non-zero if visited before
+ */
+static inline unsigned char journal_level_visited(unsigned char level) {
+    return level < JOURNAL_MAX_LEVELS && journal_level_len[level] != 0;
+}
+
+#endif // LEVEL_JOURNAL_H
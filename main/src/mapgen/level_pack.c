@@ -0,0 +1,345 @@
+// =============================================================================
+// LEVEL PACK - Pre-Generated Levels Streamed from Disk
+// Implementation - Oscar64 Optimized
+// =============================================================================
+
+#include <c64/kernalio.h>
+#include "level_pack.h"
+#include "level_cache.h"
+#include "lz_codec.h"
+#include "region_map.h"
+#include "tmea_core.h"
+#include "mapgen_api.h"
+#include "mapgen_types.h"
+#include "mapgen_internal.h"
+#include "mapgen_utils.h"
+
+// KERNAL jiffy clock (60 Hz, big-endian, $A0-$A2)
+#define JIFFY_MID   (*(volatile unsigned char *)0xA1)
+#define JIFFY_LO    (*(volatile unsigned char *)0xA2)
+
+// =============================================================================
+// GLOBAL STATE DEFINITIONS
+// =============================================================================
+
+LevelPackEntry level_pack_dir[LEVEL_PACK_MAX_LEVELS];       // 72 bytes
+unsigned char level_pack_count;                             // 1 byte
+
+unsigned int level_pack_rate = LEVEL_PACK_DEFAULT_RATE;     // 2 bytes
+unsigned int level_pack_regen_jiffies[4] = { 120, 240, 420, 960 };  // 8 bytes - ~2s/4s/7s/16s
+
+static char pack_name[LEVEL_PACK_NAME_MAX + 7];             // 21 bytes - name + "nn,S,R"
+static unsigned char pack_name_len;
+
+// Disk read buffer
+static unsigned char pack_buf[LEVEL_PACK_BUFFER];           // 64 bytes
+static unsigned char pack_pos, pack_len;
+static unsigned char pack_error;
+
+// =============================================================================
+// LOOKUP TABLES (ROM)
+// =============================================================================
+
+// Fixed-size portable level data; the counts in here size the rest
+static const CacheBlock pack_fixed_blocks[] = {
+    { &current_params,          sizeof(current_params) },
+    { &room_count,              1 },
+    { room_meta_count,          sizeof(room_meta_count) },
+    { room_metas,               sizeof(room_metas) },
+    { &global_meta_count,       1 },
+    { region_row_head,          sizeof(region_row_head) },
+    { region_col_head,          sizeof(region_col_head) },
+    { &region_span_count,       sizeof(region_span_count) },
+    { &region_corridor_count,   1 },
+    { &stairs_up_room,          1 },
+    { &stairs_down_room,        1 },
+    { &total_connections,       1 },
+    { &total_hidden_rooms,      1 },
+    { &total_niches,            1 },
+    { &total_decoys,            1 },
+    { &available_walls_count,   1 }
+};
+
+enum LevelPackBlocks {
+    PACK_FIXED_BLOCKS = sizeof(pack_fixed_blocks) / sizeof(CacheBlock),
+    PACK_VARIABLE_BLOCKS = 5            // After the map chunks: rooms, metas, spans, corridor a/b
+};
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+static unsigned int pack_jiffies(void) {
+    unsigned char mid, lo;
+    do {
+        mid = JIFFY_MID;
+        lo = JIFFY_LO;
+    } while (mid != JIFFY_MID);
+    return ((unsigned int)mid << 8) | lo;
+}
+
+static inline unsigned int pack_entry_size(const LevelPackEntry *entry) {
+    return entry->size_lo | ((unsigned int)entry->size_hi << 8);
+}
+
+// Open NAME (level 255) or NAMEnn as a sequential file for reading
+static unsigned char pack_open_file(unsigned char level) {
+    unsigned char n = pack_name_len;
+    if (level != 255) {
+        pack_name[n++] = '0' + level / 10;
+        pack_name[n++] = '0' + level % 10;
+    }
+    pack_name[n++] = ',';
+    pack_name[n++] = 'S';
+    pack_name[n++] = ',';
+    pack_name[n++] = 'R';
+    pack_name[n] = 0;
+
+    pack_pos = pack_len = 0;
+    pack_error = 0;
+    krnio_setnam(pack_name);
+    return krnio_open(2, LEVEL_PACK_DEVICE, 2);
+}
+
+// Next byte of the open file (0 and pack_error set past the end)
+static unsigned char pack_next(void) {
+    if (pack_pos == pack_len) {
+        int n = krnio_read(2, (char *)pack_buf, LEVEL_PACK_BUFFER);
+        if (n <= 0) {
+            pack_error = 1;
+            return 0;
+        }
+        pack_len = (unsigned char)n;
+        pack_pos = 0;
+    }
+    return pack_buf[pack_pos++];
+}
+
+// =============================================================================
+// PACK FUNCTIONS
+// =============================================================================
+
+unsigned char level_pack_open(const char *name) {
+    pack_name_len = 0;
+    while (*name && pack_name_len < LEVEL_PACK_NAME_MAX) pack_name[pack_name_len++] = *name++;
+
+    level_pack_count = 0;
+    if (!pack_open_file(255)) return 0;
+
+    unsigned char ok = pack_next() == LEVEL_PACK_MAGIC_0 &&
+                       pack_next() == LEVEL_PACK_MAGIC_1 &&
+                       pack_next() == LEVEL_PACK_VERSION &&
+                       pack_next() == LEVEL_PACK_BUILD;
+    unsigned char count = pack_next();
+    if (count > LEVEL_PACK_MAX_LEVELS) ok = 0;
+
+    for (unsigned char i = 0; ok && i < count; i++) {
+        unsigned char *entry = (unsigned char *)&level_pack_dir[i];
+        for (unsigned char b = 0; b < sizeof(LevelPackEntry); b++) entry[b] = pack_next();
+    }
+    krnio_close(2);
+
+    if (!ok || pack_error) return 0;
+    level_pack_count = count;
+    return 1;
+}
+
+unsigned char level_pack_load(unsigned char level) {
+    if (level >= level_pack_count) return 0;
+    const LevelPackEntry *entry = &level_pack_dir[level];
+
+    if (!pack_open_file(level)) return 0;
+
+    // Fresh level state, as generation starts from
+    mapgen_init(entry->seed_lo | ((unsigned int)entry->seed_hi << 8));
+    mapgen_set_depth(entry->depth);
+    reset_all_generation_data();
+
+    CacheBlock block;
+    for (unsigned char i = 0; level_pack_block(i, &block) && !pack_error; i++) {
+        if (block.size) lz_decompress_stream(pack_next, (unsigned char *)block.ptr, block.size);
+    }
+
+    unsigned char count = pack_next();
+    while (count-- && !pack_error) {
+        unsigned char x = pack_next(), y = pack_next(), type = pack_next();
+        TinyObj *obj = spawn_object(x, y, type);
+        unsigned char data = pack_next();
+        if (obj) obj->data = data;
+    }
+
+    count = pack_next();
+    while (count-- && !pack_error) {
+        unsigned char x = pack_next(), y = pack_next(), type = pack_next();
+        TinyMon *mon = spawn_monster(x, y, type, pack_next());
+        unsigned char flags = pack_next(), state = pack_next();
+        if (mon) {
+            mon->flags = flags;
+            mon->state = state;
+        }
+    }
+    krnio_close(2);
+
+    if (pack_error) return 0;
+    level_enter(1);
+    return 1;
+}
+
+unsigned char level_pack_regenerate(unsigned char level) {
+    if (level >= level_pack_count) return 0;
+    const LevelPackEntry *entry = &level_pack_dir[level];
+    unsigned char presets = entry->presets;
+
+    mapgen_init(entry->seed_lo | ((unsigned int)entry->seed_hi << 8));
+    mapgen_set_depth(entry->depth);
+    if (mapgen_generate_with_params(LEVEL_PACK_PRESET(presets, 0), LEVEL_PACK_PRESET(presets, 1),
+                                    LEVEL_PACK_PRESET(presets, 2), LEVEL_PACK_PRESET(presets, 3)) != 0) return 0;
+    level_enter(1);
+    return 1;
+}
+
+unsigned char level_pack_prefer_stream(unsigned char level) {
+    if (level >= level_pack_count) return 0;
+    const LevelPackEntry *entry = &level_pack_dir[level];
+
+    // Both sides in 16-jiffy units
+    unsigned int stream = pack_entry_size(entry) / level_pack_rate + LEVEL_PACK_OPEN_COST;
+    unsigned int regen = level_pack_regen_jiffies[LEVEL_PACK_PRESET(entry->presets, 0)] >> 4;
+    return stream < regen;
+}
+
+unsigned char level_pack_enter(unsigned char level) {
+    if (level >= level_pack_count) return 0;
+    const LevelPackEntry *entry = &level_pack_dir[level];
+    unsigned int start = pack_jiffies();
+
+    if (level_pack_prefer_stream(level)) {
+        if (level_pack_load(level)) {
+            // Learn the transfer rate (average with the old estimate)
+            unsigned int ticks = (pack_jiffies() - start) >> 4;
+            if (ticks > LEVEL_PACK_OPEN_COST) {
+                unsigned int rate = pack_entry_size(entry) / (ticks - LEVEL_PACK_OPEN_COST);
+                level_pack_rate = (level_pack_rate + (rate ? rate : 1)) >> 1;
+            }
+            return 1;
+        }
+        // Disk failed: regenerate, and stop preferring the disk so much
+        level_pack_rate = (level_pack_rate >> 1) | 1;
+        start = pack_jiffies();
+    }
+
+    if (!level_pack_regenerate(level)) return 0;
+
+    unsigned int *regen = &level_pack_regen_jiffies[LEVEL_PACK_PRESET(entry->presets, 0)];
+    *regen = (*regen >> 1) + ((pack_jiffies() - start) >> 1);
+    return 1;
+}
+
+// =============================================================================
+// LEVEL DATA LAYOUT
+// =============================================================================
+
+unsigned char level_pack_block(unsigned char index, CacheBlock *block) {
+    if (index < PACK_FIXED_BLOCKS) {
+        *block = pack_fixed_blocks[index];
+        return 1;
+    }
+
+    index -= PACK_FIXED_BLOCKS;
+
+    // Map storage (one block, or one per chunk with MAPGEN_LARGE_MAPS)
+    unsigned char map_chunks = map_chunk_count();
+    if (index < map_chunks) {
+        block->ptr = map_chunk_data(index, &block->size);
+        return 1;
+    }
+
+    switch (index - map_chunks) {
+        case 0:
+            block->ptr = room_list;
+            block->size = room_count * sizeof(Room);
+            return 1;
+        case 1:
+            block->ptr = global_metas;
+            block->size = global_meta_count * sizeof(GlobalTileMeta);
+            return 1;
+        case 2:
+            block->ptr = region_spans;
+            block->size = region_span_count * sizeof(RegionSpan);
+            return 1;
+        case 3:
+            block->ptr = region_corridor_room_a;
+            block->size = region_corridor_count;
+            return 1;
+        case 4:
+            block->ptr = region_corridor_room_b;
+            block->size = region_corridor_count;
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+#ifdef LEVEL_PACK_WRITER
+// =============================================================================
+// HOST WRITER
+// =============================================================================
+
+// Largest single block: the map (one block, or MAP_CHUNK_SIZE chunks),
+// room list, room metas or - in large builds - the region spans
+#define PACK_MAX2(a, b)     ((a) > (b) ? (a) : (b))
+#define PACK_MAX_BLOCK      PACK_MAX2(PACK_MAX2(COMPACT_MAP_SIZE, sizeof(room_list)), \
+                                      PACK_MAX2(sizeof(region_spans), sizeof(room_metas)))
+
+#ifdef MAPGEN_LARGE_MAPS
+#define PACK_MAP_BYTES      (MAP_CHUNK_SIZE * MAP_CHUNKS)
+#else
+#define PACK_MAP_BYTES      COMPACT_MAP_SIZE
+#endif
+
+// Worst case LZ output of the largest block (all literals)
+static unsigned char pack_work[PACK_MAX_BLOCK + PACK_MAX_BLOCK / 128 + 1];
+
+unsigned int level_pack_max_data(void) {
+    unsigned int size = PACK_MAP_BYTES + sizeof(room_list) + sizeof(global_metas) + sizeof(region_spans)
+                      + sizeof(region_corridor_room_a) + sizeof(region_corridor_room_b);
+    for (unsigned char i = 0; i < PACK_FIXED_BLOCKS; i++) size += pack_fixed_blocks[i].size;
+    return size;
+}
+
+
+void level_pack_write_level(LevelPackSink sink) {
+    CacheBlock block;
+    for (unsigned char i = 0; level_pack_block(i, &block); i++) {
+        if (!block.size) continue;
+        unsigned int n = lz_compress((const unsigned char *)block.ptr, block.size,
+                                     pack_work, sizeof(pack_work));
+        for (unsigned int b = 0; b < n; b++) sink(pack_work[b]);
+    }
+
+    // Entities in spawn order: the active lists are newest first
+    TinyObj *objs[MAX_TINY_OBJECTS];
+    unsigned char count = 0;
+    for (TinyObj *obj = obj_active_list; obj; obj = obj->next) objs[count++] = obj;
+    sink(count);
+    while (count--) {
+        sink(objs[count]->x);
+        sink(objs[count]->y);
+        sink(objs[count]->type);
+        sink(objs[count]->data);
+    }
+
+    TinyMon *mons[MAX_TINY_MONSTERS];
+    count = 0;
+    for (TinyMon *mon = mon_active_list; mon; mon = mon->next) mons[count++] = mon;
+    sink(count);
+    while (count--) {
+        sink(mons[count]->x);
+        sink(mons[count]->y);
+        sink(mons[count]->type);
+        sink(mons[count]->hp);
+        sink(mons[count]->flags);
+        sink(mons[count]->state);
+    }
+}
+#endif
@@ -0,0 +1,166 @@
+#ifndef LEVEL_PACK_H
+#define LEVEL_PACK_H
+
+// =============================================================================
+// LEVEL PACK - Pre-Generated Levels Streamed from Disk
+// =============================================================================
+//
+// A level pack holds a Quest's levels generated on the host by
+// tools/levelpack (native build of this mapgen). Each level is stored
+// LZ-compressed; the loader decodes straight from the disk buffer into
+// compact_map, room_list, TMEA and region data - no staging copy.
+//
+// Files (SEQ, on one .d64):
+// - NAME      index: 'L' 'P' version build count, then count LevelPackEntry
+// - NAMEnn    level nn (two decimal digits):
+//             level_pack_block() blocks, each LZ-compressed, then
+//             object count + count * (x y type data) and
+//             monster count + count * (x y type hp flags state),
+//             both in spawn order
+//
+// CBM DOS cannot seek inside a sequential file, so every level has its
+// own file instead of being an offset into one big one.
+//
+// The stream format is portable: byte-sized fields only, no pointers, so
+// the host tool and the C64 agree on it. Pool links are rebuilt by
+// spawning the entities in their original order.
+//
+// Regenerate or stream: level_pack_enter() compares the predicted disk
+// time (compressed size / measured transfer rate) with the measured
+// generation time for the level's map size and takes the faster path.
+// Both estimates start from defaults and learn from every load, so a
+// fast loader or drive speeder shifts the choice automatically.
+//
+// Memory: 72 bytes directory + 64 bytes disk buffer + 30 bytes
+//
+// =============================================================================
+
+#include "level_cache.h"    // CacheBlock
+
+enum LevelPackConstants {
+    LEVEL_PACK_MAX_LEVELS = 12,         // Quest mode depth
+    LEVEL_PACK_NAME_MAX = 14,           // Pack name characters (+2 digits)
+    LEVEL_PACK_BUFFER = 64,             // Disk read buffer
+    LEVEL_PACK_DEVICE = 8,
+    LEVEL_PACK_OBJ_RECORD = 4,          // x y type data
+    LEVEL_PACK_MON_RECORD = 6           // x y type hp flags state
+};
+
+#define LEVEL_PACK_MAGIC_0  'L'
+#define LEVEL_PACK_MAGIC_1  'P'
+#define LEVEL_PACK_VERSION  2
+
+// Build mode byte: MAPGEN_LARGE_MAPS changes the map chunks, the
+// MAX_ROOMS sized blocks and the region span width, so a pack only
+// loads in the build mode that wrote it
+#define LEVEL_PACK_BUILD    MAX_ROOMS
+
+// Transfer rate in bytes per 16 jiffies (~400 bytes/s for a stock 1541)
+#ifndef LEVEL_PACK_DEFAULT_RATE
+#define LEVEL_PACK_DEFAULT_RATE 107
+#endif
+
+// File opens and directory search, in 16-jiffy units (~0.5s)
+#define LEVEL_PACK_OPEN_COST    2
+
+// Presets byte: 2 bits each (map_size, hidden_rooms, niches, deception)
+#define LEVEL_PACK_PRESETS(map_size, hidden, niches, deception) \
+    ((map_size) | ((hidden) << 2) | ((niches) << 4) | ((deception) << 6))
+#define LEVEL_PACK_PRESET(presets, index)   (((presets) >> ((index) * 2)) & 0x03)
+
+// Index entry (6 bytes, stored as is in the index file)
+typedef struct {
+    unsigned char seed_lo, seed_hi;     // mapgen_init() seed
+    unsigned char depth;                // mapgen_set_depth()
+    unsigned char presets;              // LEVEL_PACK_PRESETS()
+    unsigned char size_lo, size_hi;     // Level file size in bytes
+} LevelPackEntry;
+
+// =============================================================================
+// GLOBAL STATE DECLARATIONS
+// =============================================================================
+
+extern LevelPackEntry level_pack_dir[LEVEL_PACK_MAX_LEVELS];    // 72 bytes
+extern unsigned char level_pack_count;                          // Levels in pack
+
+// Load time model (see level_pack_enter)
+extern unsigned int level_pack_rate;                    // Bytes per 16 jiffies
+extern unsigned int level_pack_regen_jiffies[4];        // Per map size preset
+
+// =============================================================================
+// PACK FUNCTIONS
+// =============================================================================
+
+/**
+ * @brief Read the index of a level pack
+ * @param name PETSCII pack name (max 14 chars)
+ * @return 1 on success, 0 if missing or not a level pack
+ */
+unsigned char level_pack_open(const char *name);
+
+/**
+ * @brief Stream a level from disk and make it current
+ * @param level Level number
+ * @return 1 on success, 0 on disk error (current level is then undefined)
+ *
+ * Enters the level as a fresh one (level_enter).
+ */
+unsigned char level_pack_load(unsigned char level);
+
+/**
+ * @brief Generate a level from its pack entry (seed, depth, presets)
+ * @param level Level number
+ * @return 1 on success, 0 if not in the pack or generation failed
+ *
+ * Enters the level as a fresh one (level_enter).
+ */
+unsigned char level_pack_regenerate(unsigned char level);
+
+/**
+ * @brief Check which way is predicted to be faster
+ * @param level Level number
+ * @return 1 if streaming beats regeneration
+ */
+unsigned char level_pack_prefer_stream(unsigned char level);
+
+/**
+ * @brief Make a level current the fastest way, timing it for next time
+ * @param level Level number
+ * @return 1 on success, 0 if the level is not in the pack or failed
+ *
+ * A failed stream falls back to regeneration. Either way the level is
+ * the same one: the pack was generated from the same seed and code.
+ */
+unsigned char level_pack_enter(unsigned char level);
+
+/**
+ * @brief Get one portable data block of the current level
+ * @param index Block number, counting from 0
+ * @param block Output address and size
+ * @return 1 if the block exists, 0 past the last block
+ *
+ * Same walking rule as level_snapshot_block(): sizes of later blocks
+ * come from counts restored by earlier ones.
+ */
+unsigned char level_pack_block(unsigned char index, CacheBlock *block);
+
+#ifdef LEVEL_PACK_WRITER
+// Output byte sink for the host tool
+typedef void (*LevelPackSink)(unsigned char value);
+
+/**
+ * @brief Write the current level in level file format (host tool only)
+ * @param sink Receives the file bytes
+ */
+void level_pack_write_level(LevelPackSink sink);
+
+/**
+ * @brief Level data bytes with every block at full capacity (host tool only)
+ * @return Sum of the level_pack_block() sizes of the largest possible level
+ *
+ * Entities and LZ overhead are not included.
+ */
+unsigned int level_pack_max_data(void);
+#endif
+
+#endif // LEVEL_PACK_H
@@ -0,0 +1,135 @@
+// =============================================================================
+// LZ CODEC - Byte-Oriented LZ77 for Level Data
+// Implementation - Oscar64 Optimized
+// =============================================================================
+
+#include "lz_codec.h"
+
+// =============================================================================
+// GLOBAL STATE DEFINITIONS
+// =============================================================================
+
+static unsigned int lz_hash[LZ_HASH_SIZE];                  // 128 bytes - last position per hash
+
+// Encoder output state
+static unsigned char *lz_out;
+static unsigned int lz_out_len, lz_out_max;
+
+#define LZ_NO_POS 0xFFFF
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+static inline unsigned char lz_hash_at(const unsigned char *p) {
+    return ((p[0] << 2) ^ (p[1] << 1) ^ p[2]) & (LZ_HASH_SIZE - 1);
+}
+
+// Length of match between a and b (a < b), at most limit bytes
+static unsigned char lz_match_len(const unsigned char *a, const unsigned char *b, unsigned char limit) {
+    unsigned char n = 0;
+    while (n < limit && a[n] == b[n]) n++;
+    return n;
+}
+
+static void lz_put(unsigned char value) {
+    if (lz_out_len < lz_out_max) lz_out[lz_out_len] = value;
+    lz_out_len++;
+}
+
+static void lz_put_literals(const unsigned char *src, unsigned int count) {
+    while (count) {
+        unsigned char run = (count > LZ_MAX_LITERALS) ? LZ_MAX_LITERALS : (unsigned char)count;
+        lz_put(run - 1);
+        for (unsigned char i = 0; i < run; i++) lz_put(src[i]);
+        src += run;
+        count -= run;
+    }
+}
+
+// =============================================================================
+// CODEC FUNCTIONS
+// =============================================================================
+
+unsigned int lz_compress(const unsigned char *src, unsigned int len,
+                         unsigned char *dst, unsigned int max) {
+    unsigned int i = 0, lit = 0;
+
+    lz_out = dst;
+    lz_out_len = 0;
+    lz_out_max = max;
+    for (unsigned char h = 0; h < LZ_HASH_SIZE; h++) lz_hash[h] = LZ_NO_POS;
+
+    while (i + LZ_MIN_MATCH <= len && lz_out_len <= lz_out_max) {
+        unsigned int left = len - i;
+        unsigned char limit = (left > LZ_MAX_MATCH) ? LZ_MAX_MATCH : (unsigned char)left;
+        unsigned char best = 0, best_off = 0;
+
+        // Run of the previous byte (offset 1)
+        if (i > 0) {
+            best = lz_match_len(src + i - 1, src + i, limit);
+        }
+
+        // Last position with the same 3-byte hash
+        unsigned char h = lz_hash_at(src + i);
+        unsigned int cand = lz_hash[h];
+        lz_hash[h] = i;
+        if (cand != LZ_NO_POS && i - cand <= LZ_WINDOW && i - cand > 1) {
+            unsigned char n = lz_match_len(src + cand, src + i, limit);
+            if (n > best) {
+                best = n;
+                best_off = (unsigned char)(i - cand - 1);
+            }
+        }
+
+        if (best >= LZ_MIN_MATCH) {
+            lz_put_literals(src + lit, i - lit);
+            lz_put(LZ_MATCH_FLAG | (best - 2));
+            lz_put(best_off);
+            i += best;
+            lit = i;
+        } else {
+            i++;
+        }
+    }
+    lz_put_literals(src + lit, len - lit);
+
+    return (lz_out_len <= lz_out_max) ? lz_out_len : 0;
+}
+
+unsigned int lz_decompress(const unsigned char *src, unsigned char *dst, unsigned int len) {
+    const unsigned char *p = src;
+    unsigned char *end = dst + len;
+
+    while (dst < end) {
+        unsigned char token = *p++;
+        if (token & LZ_MATCH_FLAG) {
+            unsigned char count = (token & 0x7F) + 2;
+            const unsigned char *from = dst - *p++ - 1;
+            // Forward byte copy: overlapping offsets repeat the pattern
+            do { *dst++ = *from++; } while (--count);
+        } else {
+            unsigned char count = token + 1;
+            do { *dst++ = *p++; } while (--count);
+        }
+    }
+    return (unsigned int)(p - src);
+}
+
+void lz_decompress_stream(LzSource source, unsigned char *dst, unsigned int len) {
+    unsigned char *end = dst + len;
+
+    while (dst < end) {
+        unsigned char token = source();
+        if (token & LZ_MATCH_FLAG) {
+            unsigned char count = (token & 0x7F) + 2;
+            const unsigned char *from = dst - source() - 1;
+            if (count > end - dst) count = end - dst;       // Damaged stream
+            do { *dst++ = *from++; } while (--count);
+        } else {
+            unsigned char count = token + 1;
+            if (count > end - dst) count = end - dst;
+            do { *dst++ = source(); } while (--count);
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef LZ_CODEC_H
+#define LZ_CODEC_H
+
+// =============================================================================
+// LZ CODEC - Byte-Oriented LZ77 for Level Data
+// =============================================================================
+//
+// Small LZ77 variant tuned for the 6502: no bit streams, 8-bit offsets,
+// decoder is a pair of byte-copy loops.
+//
+// Stream format (token byte, then payload):
+// - 0xxxxxxx              literal run: x+1 bytes follow (1-128)
+// - 1xxxxxxx oooooooo     match: copy x+2 bytes (3-129 used) from
+//                         o+1 bytes back (1-256); overlapping copies
+//                         turn offset 1 into run-length fill
+//
+// The packed 3-bit map is mostly rock (0x00 runs) and repeated wall
+// rows, so long zero runs cost 2 bytes per 129 and repeats within
+// ~8 map rows are found by the match search.
+//
+// Encoder: greedy, candidates from a 64-entry hash of the next 3 bytes
+// plus the previous byte (run check) - no window scan.
+//
+// Performance: decode ~25 cycles per output byte, encode ~150
+// Memory: 128 bytes hash table
+//
+// =============================================================================
+
+enum LzConstants {
+    LZ_MIN_MATCH = 3,
+    LZ_MAX_MATCH = 129,
+    LZ_MAX_LITERALS = 128,
+    LZ_WINDOW = 256,
+    LZ_HASH_SIZE = 64
+};
+
+#define LZ_MATCH_FLAG 0x80
+
+// Byte source for streamed decompression (next compressed byte)
+typedef unsigned char (*LzSource)(void);
+
+/**
+ * @brief Compress a block
+ * @param src Input data
+ * @param len Input length
+ * @param dst Output buffer
+ * @param max Output buffer size
+ * @return Compressed size, or 0 if it does not fit in max bytes
+ *
+ * Worst case output is len + len / 128 + 1 bytes (all literals).
+ */
+unsigned int lz_compress(const unsigned char *src, unsigned int len,
+                         unsigned char *dst, unsigned int max);
+
+/**
+ * @brief Decompress a block
+ * @param src Compressed stream
+ * @param dst Output buffer
+ * @param len Decompressed size (as passed to lz_compress)
+ * @return Number of compressed bytes consumed
+ */
+unsigned int lz_decompress(const unsigned char *src, unsigned char *dst, unsigned int len);
+
+/**
+ * @brief Decompress a block read byte by byte from a source
+ * @param source Returns the next compressed byte (e.g. a disk buffer)
+ * @param dst Output buffer
+ * @param len Decompressed size
+ *
+ * Same stream format as lz_decompress; lets a loader decode straight
+ * from disk into the destination without staging the compressed block.
+ */
+void lz_decompress_stream(LzSource source, unsigned char *dst, unsigned int len);
+
+#endif // LZ_CODEC_H
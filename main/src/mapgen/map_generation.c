@@ -9,6 +9,12 @@
 #include "mapgen_display.h"    // For initialize_camera, reset_viewport_state, reset_display_state
 #include "mapgen_config.h"     // For MapParameters
 #include "mapgen_progress.h"   // For progress bar functions (DEBUG only)
+#include "mapgen_raster.h"     // For RASTER_MARK (MAPGEN_RASTER_TIMING only)
+#include "mapgen_api.h"        // For mapgen_set_depth
+#include "room_path.h"         // For room_path_edge_cost
+#include "spawn_tables.h"      // For weighted item/monster spawning
+#include "tmea_core.h"         // For spawn_monster, get_objects_at
+#include "tmea_data.h"         // For monster_table
 
 // =============================================================================
 // DYNAMIC GENERATION PARAMETERS
@@ -39,6 +45,29 @@ unsigned char total_niches = 0;          // Wall niches placed
 unsigned char total_decoys = 0;          // Decoy corridors placed
 unsigned char available_walls_count = 0; // Walls without doors
 
+// Retries and rejections per phase (mapgen_get_stats)
+MapgenStats mapgen_stats;                // 17 bytes
+
+// Stair rooms (set by add_stairs, 255 = none)
+unsigned char stairs_up_room = 255;
+unsigned char stairs_down_room = 255;
+
+// Up stairs pin (mapgen_pin_up_stairs, 255 = none) and the room
+// create_rooms() centred on it (255 = not placed)
+unsigned char stairs_pin_x = 255;
+unsigned char stairs_pin_y = 255;
+unsigned char stairs_pin_room = 255;
+
+// Walk length from the up stairs room to each room and to the down
+// stairs (set by select_stair_rooms, STAIRS_NO_DISTANCE = not reached)
+unsigned int stairs_room_distance[MAX_ROOMS];      // 50 bytes
+unsigned int stairs_path_length = STAIRS_NO_DISTANCE;
+
+// Corridor graph walk state
+static unsigned char stairs_entry_x[MAX_ROOMS];    // MAX_ROOMS bytes - door the room is entered by
+static unsigned char stairs_entry_y[MAX_ROOMS];    // MAX_ROOMS bytes
+static unsigned char stairs_queue[MAX_ROOMS];      // MAX_ROOMS bytes
+
 // =============================================================================
 // PHASE 1: ROOM CREATION
 // =============================================================================
@@ -55,7 +84,53 @@ unsigned char available_walls_count = 0; // Walls without doors
 // PHASE 3: STAIR PLACEMENT SYSTEM
 // =============================================================================
 
-// Place stairs in rooms with maximum distance for optimal separation
+// Walk lengths from start over the corridor graph (measure_stair_walks).
+// Returns the farthest non-hidden room (any room if all are hidden,
+// start if none is reached).
+static unsigned char measure_from_room(unsigned char start) {
+    measure_stair_walks(start, 255);
+
+    unsigned char far_room = start, far_any = start;
+    unsigned int far_dist = 0, far_any_dist = 0;
+
+    for (unsigned char i = 0; i < room_count; i++) {
+        unsigned int dist = stairs_room_distance[i];
+        if (dist == STAIRS_NO_DISTANCE) continue;
+
+        if (dist > far_any_dist) { far_any_dist = dist; far_any = i; }
+        if (dist > far_dist && !(room_list[i].state & ROOM_HIDDEN)) { far_dist = dist; far_room = i; }
+    }
+
+    return (far_room != start) ? far_room : far_any;
+}
+
+// Pick the stair rooms at the ends of the longest walk through the
+// corridor graph (its diameter, found with two sweeps): from any room
+// the farthest room is one end, and the farthest from that the other.
+// A pinned up room is one end already and needs a single sweep.
+// Leaves stairs_room_distance[] measured from the up room.
+void select_stair_rooms(unsigned char *up_room, unsigned char *down_room) {
+    unsigned char up = stairs_pin_room;
+    if (up == 255) up = measure_from_room(0);
+    unsigned char down = measure_from_room(up);
+
+    // Up room not joined to any other (corridor failures): farthest
+    // room centre instead, so the stairs still get two rooms
+    if (down == up) {
+        unsigned char best = 0;
+        for (unsigned char i = 0; i < room_count; i++) {
+            unsigned char dist = manhattan_distance(room_list[up].center_x, room_list[up].center_y,
+                                                    room_list[i].center_x, room_list[i].center_y);
+            if (dist > best) { best = dist; down = i; }
+        }
+    }
+
+    stairs_path_length = stairs_room_distance[down];
+    *up_room = up;
+    *down_room = down;
+}
+
+// Place stairs in the rooms select_stair_rooms() picks
 void add_stairs(void) {
     if (room_count < 2) return; // Need at least 2 rooms for stairs
 
@@ -64,27 +139,15 @@ void add_stairs(void) {
     update_progress_step(6, 0, 2);
 #endif
 
-    // Find room pair with maximum distance (brute-force optimal)
-    unsigned char start_room = 0;
-    unsigned char end_room = 1;
-    unsigned char max_distance = calculate_room_distance(0, 1);
-
-    for (unsigned char i = 0; i < room_count; i++) {
-        for (unsigned char j = i + 1; j < room_count; j++) {
-            unsigned char dist = calculate_room_distance(i, j);
-            if (dist > max_distance) {
-                max_distance = dist;
-                start_room = i;
-                end_room = j;
-            }
-        }
-    }
+    unsigned char start_room, end_room;
+    select_stair_rooms(&start_room, &end_room);
 
     // Place up stairs in starting room center
     // Direct metadata access - cached room centers
     unsigned char up_x = room_list[start_room].center_x;
     unsigned char up_y = room_list[start_room].center_y;
     set_compact_tile(up_x, up_y, TILE_UP);
+    stairs_up_room = start_room;
 
 #ifdef DEBUG_MAPGEN
     update_progress_step(6, 1, 2);
@@ -94,6 +157,7 @@ void add_stairs(void) {
     unsigned char down_x = room_list[end_room].center_x;
     unsigned char down_y = room_list[end_room].center_y;
     set_compact_tile(down_x, down_y, TILE_DOWN);
+    stairs_down_room = end_room;
 
 #ifdef DEBUG_MAPGEN
     // Phase 6: Stair placement complete
@@ -101,6 +165,141 @@ void add_stairs(void) {
 #endif
 }
 
+// =============================================================================
+// PHASE 4: ROOM POPULATION
+// =============================================================================
+// One pass over the finished rooms using metadata generation already has:
+// - Hidden rooms:   guardian (stronger of two monster picks) + 2 items
+// - Niches:         item on the niche tile behind the secret door
+// - Decoy corridors: item at the dead end
+// - Far rooms:      monsters (walk from the up-stairs room >= half of the
+//                   walk between the stairs), near rooms an occasional item
+
+// Niche tile position from niche_wall_side (not stored, only the side is)
+static unsigned char find_niche_tile(const Room *room, unsigned char *out_x, unsigned char *out_y) {
+    unsigned char side = room->niche_wall_side;
+    unsigned char len = (side < 2) ? room->h : room->w;
+
+    for (unsigned char i = 1; i + 1 < len; i++) {
+        unsigned char wall_x, wall_y, niche_x, niche_y;
+
+        if (side == 0) {
+            wall_x = room->x - 1; wall_y = room->y + i;
+            niche_x = wall_x - 1; niche_y = wall_y;
+        } else if (side == 1) {
+            wall_x = room->x + room->w; wall_y = room->y + i;
+            niche_x = wall_x + 1; niche_y = wall_y;
+        } else if (side == 2) {
+            wall_x = room->x + i; wall_y = room->y - 1;
+            niche_x = wall_x; niche_y = wall_y - 1;
+        } else {
+            wall_x = room->x + i; wall_y = room->y + room->h;
+            niche_x = wall_x; niche_y = wall_y + 1;
+        }
+
+        // Niche door is a secret door (TILE_MARKER) until revealed
+        unsigned char door = get_compact_tile(wall_x, wall_y);
+        if ((door == TILE_DOOR || (door == TILE_MARKER && is_door_secret(wall_x, wall_y))) &&
+            get_compact_tile(niche_x, niche_y) == TILE_FLOOR) {
+            *out_x = niche_x;
+            *out_y = niche_y;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Item on a single tile if nothing is there yet
+static void populate_tile(unsigned char x, unsigned char y) {
+    if (get_compact_tile(x, y) == TILE_FLOOR && !get_objects_at(x, y)) {
+        spawn_random_object(x, y);
+    }
+}
+
+// Guardian at the room center (or a free tile if stairs are there);
+// returns 1 if it was spawned
+static unsigned char populate_guardian(const Room *room) {
+    unsigned char type = spawn_pick(&spawn_monsters);
+    unsigned char other = spawn_pick(&spawn_monsters);
+    if (monster_table[other].xp_value > monster_table[type].xp_value) type = other;
+
+    unsigned char x = room->center_x;
+    unsigned char y = room->center_y;
+    if (get_compact_tile(x, y) != TILE_FLOOR || get_monster_at(x, y)) {
+        x = room->x + rnd(room->w);
+        y = room->y + rnd(room->h);
+        if (get_compact_tile(x, y) != TILE_FLOOR || get_monster_at(x, y)) return 0;
+    }
+
+    TinyMon *mon = spawn_monster(x, y, type, monster_table[type].base_hp);
+    if (!mon) return 0;
+    mon->state = MSTATE_GUARD;
+    return 1;
+}
+
+void populate_rooms(void) {
+    if (room_count == 0) return;
+
+    // Tables for the current depth (builds depth 0 on first use)
+    if (spawn_depth == 255) spawn_set_depth(0);
+
+    // Walk lengths from select_stair_rooms(); without stairs (or without
+    // a path between them) no room counts as far
+    unsigned char has_stairs = stairs_up_room < room_count && stairs_down_room < room_count;
+    unsigned int far_distance = STAIRS_NO_DISTANCE;
+    if (has_stairs && stairs_path_length != STAIRS_NO_DISTANCE) {
+        far_distance = stairs_path_length >> 1;
+    }
+
+    // Dark rooms: 20% at depth 0 rising to 65% at SPAWN_MAX_DEPTH
+    unsigned char dark_chance = 20 + 3 * (spawn_depth < SPAWN_MAX_DEPTH ? spawn_depth : SPAWN_MAX_DEPTH);
+
+    // Monster pool is small: keep one slot per hidden room for its guardian
+    unsigned char mon_left = MAX_TINY_MONSTERS;
+    unsigned char guard_reserve = total_hidden_rooms;
+
+    for (unsigned char i = 0; i < room_count; i++) {
+        const Room *room = &room_list[i];
+
+        // The arrival room stays lit
+        if (i != stairs_up_room && rnd(100) < dark_chance) room_list[i].state |= ROOM_DARK;
+
+        if (room->state & ROOM_HIDDEN) {
+            if (guard_reserve) guard_reserve--;
+            // No guardian next to the player's arrival point
+            if (i != stairs_up_room && mon_left && populate_guardian(room)) {
+                mon_left--;
+            }
+            spawn_populate_room(i, 2, 0);
+        } else if (i != stairs_up_room) {
+            unsigned int dist = stairs_room_distance[i];
+            if (dist != STAIRS_NO_DISTANCE && dist >= far_distance) {
+                // Farthest quarter gets a second monster
+                unsigned char monsters = (dist >= far_distance + (far_distance >> 1)) ? 2 : 1;
+                unsigned char budget = (mon_left > guard_reserve) ? mon_left - guard_reserve : 0;
+                if (monsters > budget) monsters = budget;
+                mon_left -= monsters;
+                spawn_populate_room(i, 1, monsters);
+            } else if (rnd(2)) {
+                spawn_populate_room(i, 1, 0);
+            }
+        }
+
+        if (room->state & ROOM_HAS_NICHE) {
+            unsigned char nx, ny;
+            if (find_niche_tile(room, &nx, &ny)) populate_tile(nx, ny);
+        }
+        if ((room->state & ROOM_HAS_DECOY) && room->decoy_end_x != 255) {
+            populate_tile(room->decoy_end_x, room->decoy_end_y);
+        }
+
+#ifdef DEBUG_MAPGEN
+        // Phase 7: Room population progress
+        update_progress_step(7, i + 1, room_count);
+#endif
+    }
+}
+
 // =============================================================================
 // POST-MST FEATURE COUNT CALCULATION
 // =============================================================================
@@ -135,24 +334,19 @@ void calculate_post_mst_feature_counts(void) {
 // MAIN MAP GENERATION PIPELINE
 // =============================================================================
 
-// Level generation pipeline with incremental wall building
-unsigned char generate_level(void) {
+// Layout phases up to the stairs: rooms, corridors, hidden rooms, niches
+// and deception. Returns 0 if no room was placed.
+unsigned char generate_layout(void) {
 
 #ifdef DEBUG_MAPGEN
-    // Initialize progress bar system
-    init_generation_progress();
-    init_progress_weights();  // Pre-calculate phase boundaries with initial estimates
-
     // Phase 1: Create rooms with walls using grid-based placement
     show_phase(0); // "Building Rooms"
 #endif
 
+    RASTER_MARK(RASTER_ROOMS);
     create_rooms();
     // Early exit if no rooms were created
     if (room_count == 0) {
-#ifdef DEBUG_MAPGEN
-        finish_progress_bar();
-#endif
         return 0; // Generation failed
     }
 
@@ -164,12 +358,14 @@ unsigned char generate_level(void) {
     // Phase 2: Room Connection System with corridor walls
     show_phase(1); // "Connecting Rooms"
 #endif
+    RASTER_MARK(RASTER_CORRIDORS);
     build_room_network();
 
 #ifdef DEBUG_MAPGEN
     // Phase 2: Convert single-connection rooms to hidden rooms
     show_phase(2); // "Hiding Rooms"
 #endif
+    RASTER_MARK(RASTER_HIDDEN);
     place_hidden_rooms(current_params.hidden_room_count);
 
     // POST-MST CALCULATION: Calculate feature counts using runtime data
@@ -179,30 +375,65 @@ unsigned char generate_level(void) {
     // Phase 3: Carve wall niches
     show_phase(3); // "Carving Niches"
 #endif
+    RASTER_MARK(RASTER_NICHES);
     place_niches(current_params.niche_count);
 
 #ifdef DEBUG_MAPGEN
     // Phase 4: Place decoy corridors (dead-ends)
     show_phase(4); // "Decoys"
 #endif
+    RASTER_MARK(RASTER_DECOYS);
     place_decoy_corridors(current_params.deception_count);
 
 #ifdef DEBUG_MAPGEN
     // Phase 5: Hide passages (use actual decoy count for balance)
     show_phase(5); // "Hidden Passages"
 #endif
+    RASTER_MARK(RASTER_PASSAGES);
     place_hidden_passages(total_decoys);
 
+    return 1;
+}
+
+// Level generation pipeline with incremental wall building
+unsigned char generate_level(void) {
+
+#ifdef DEBUG_MAPGEN
+    // Initialize progress bar system
+    init_generation_progress();
+    init_progress_weights();  // Pre-calculate phase boundaries with initial estimates
+#endif
+
+    if (!generate_layout()) {
+        RASTER_MARK(RASTER_IDLE);
+#ifdef DEBUG_MAPGEN
+        finish_progress_bar();
+#endif
+        return 0; // Generation failed
+    }
+
 #ifdef DEBUG_MAPGEN
     // Phase 3: Place stairs for level navigation
     show_phase(6); // "Placing Stairs"
 #endif
+    RASTER_MARK(RASTER_STAIRS);
     add_stairs();
 
+#ifdef DEBUG_MAPGEN
+    // Phase 4: Place items and monsters
+    show_phase(7); // "Populating Rooms"
+#endif
+    RASTER_MARK(RASTER_POPULATE);
+    populate_rooms();
+    RASTER_MARK(RASTER_IDLE);
+
 #ifdef DEBUG_MAPGEN
     // Finish progress bar and show completion message
     finish_progress_bar();
-    show_phase(7); // "Complete"
+    show_phase(8); // "Complete"
+
+    // Benchmark runs: no preview
+    if (progress_muted) return 1;
 
     // Initialize camera for debug preview mode
     initialize_camera();
@@ -230,6 +461,11 @@ unsigned char generate_level(void) {
 // =============================================================================
 // PUBLIC API FUNCTIONS
 // =============================================================================
+// State-only calls: resident even in the overlay build
+
+#ifdef MAPGEN_OVERLAY
+#pragma code(code)
+#endif
 
 // Set generation parameters from configuration
 void mapgen_set_parameters(const MapParameters *params) {
@@ -238,6 +474,17 @@ void mapgen_set_parameters(const MapParameters *params) {
     }
 }
 
+// Set dungeon depth for item/monster selection of following generations
+void mapgen_set_depth(unsigned char depth) {
+    spawn_set_depth(depth);
+}
+
+// Pin the up stairs of following generations (255 clears the pin)
+void mapgen_pin_up_stairs(unsigned char x, unsigned char y) {
+    stairs_pin_x = x;
+    stairs_pin_y = y;
+}
+
 // Get current generation parameters (for testing/debugging)
 void mapgen_get_parameters(MapParameters *params) {
     if (params) {
@@ -245,6 +492,63 @@ void mapgen_get_parameters(MapParameters *params) {
     }
 }
 
+// Copy the statistics of the last generation
+void mapgen_get_stats(MapgenStats *stats) {
+    if (stats) {
+        *stats = mapgen_stats;
+    }
+}
+
+// Walk lengths from the up room to each room centre (the stairs tile)
+// and to the down room, in BFS order over the corridor graph. The
+// corridors are the MST edges, so every room is reached by exactly one
+// path and visited once: O(rooms). Edge cost as in room_path. Resident:
+// snapshots do not store the lengths, level_snapshot_rebuild() measures
+// them again for a restored level.
+void measure_stair_walks(unsigned char up_room, unsigned char down_room) {
+    for (unsigned char i = 0; i < room_count; i++) {
+        stairs_room_distance[i] = STAIRS_NO_DISTANCE;
+    }
+    stairs_path_length = STAIRS_NO_DISTANCE;
+    if (up_room >= room_count) return;
+
+    // Queued rooms hold the walk to their entry door until visited
+    stairs_room_distance[up_room] = 0;
+    stairs_entry_x[up_room] = room_list[up_room].center_x;
+    stairs_entry_y[up_room] = room_list[up_room].center_y;
+    stairs_queue[0] = up_room;
+
+    unsigned char head = 0, tail = 1;
+    while (head < tail) {
+        unsigned char u = stairs_queue[head++];
+        const Room *room = &room_list[u];
+        unsigned char ex = stairs_entry_x[u];
+        unsigned char ey = stairs_entry_y[u];
+        unsigned int at_entry = stairs_room_distance[u];
+
+        for (unsigned char c = 0; c < room->connections; c++) {
+            unsigned char v = room->conn_data[c].room_id;
+            if (v >= room_count || stairs_room_distance[v] != STAIRS_NO_DISTANCE) continue;
+
+            unsigned int edge = room_path_edge_cost(u, c, ex, ey, 0, &stairs_entry_x[v], &stairs_entry_y[v]);
+            if (edge == ROOM_PATH_NO_COST) continue;
+
+            stairs_room_distance[v] = at_entry + edge;
+            stairs_queue[tail++] = v;
+        }
+
+        // Room distance is measured to its centre
+        stairs_room_distance[u] = at_entry + manhattan_distance(ex, ey, room->center_x, room->center_y);
+    }
+
+    if (down_room < room_count) stairs_path_length = stairs_room_distance[down_room];
+}
+
+// Walk length from the up stairs room to a room of the current level
+unsigned int mapgen_get_room_distance(unsigned char room) {
+    return (room < room_count) ? stairs_room_distance[room] : STAIRS_NO_DISTANCE;
+}
+
 // Get current map size (width == height)
 unsigned char mapgen_get_map_size(void) {
     return current_params.map_width;
@@ -9,19 +9,26 @@ void mapgen_init(unsigned int seed);           // Set explicit 16-bit seed
 unsigned int mapgen_get_seed(void);            // Query current seed value
 void mapgen_reset_seed_flag(void);             // Reset to random seed on next generation
 void mapgen_set_parameters(const MapParameters *params);
+void mapgen_set_depth(unsigned char depth);    // Dungeon level for item/monster spawn weights
+void mapgen_pin_up_stairs(unsigned char x, unsigned char y); // Up stairs room centred here (255 = free)
 
 // Public API for map generation
 unsigned char mapgen_generate_dungeon(void);
 
 // Production mode API - direct parameter generation
 unsigned char mapgen_generate_with_params(
-    unsigned char map_size,      // 0=SMALL, 1=MEDIUM, 2=LARGE
+    unsigned char map_size,      // 0=SMALL, 1=MEDIUM, 2=LARGE, 3=HUGE (MAPGEN_LARGE_MAPS)
     unsigned char hidden_rooms,  // 0=10%, 1=25%, 2=50%
     unsigned char niches,        // 0=10%, 1=25%, 2=50%
     unsigned char deception      // 0=10%, 1=25%, 2=50%
 );
 
+// Multi-level planning - per-level seeds and lined-up stairs (dungeon_set.h)
+unsigned char mapgen_generate_dungeon_set(unsigned int master_seed, unsigned char depth);
+
 // Query functions
 unsigned char mapgen_get_map_size(void);
+void mapgen_get_stats(MapgenStats *stats);     // Retries and rejections of the last generation
+unsigned int mapgen_get_room_distance(unsigned char room); // Walk from the up stairs (0xFFFF = not reached)
 
 #endif // MAPGEN_API_H
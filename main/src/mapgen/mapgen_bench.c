@@ -0,0 +1,374 @@
+// =============================================================================
+// Map Generator Benchmark Module Implementation
+// =============================================================================
+// DEBUG-only on-target timing of generation runs (see mapgen_bench.h).
+//
+// Only compiled when DEBUG_MAPGEN is defined.
+// =============================================================================
+
+#ifdef DEBUG_MAPGEN
+
+#include <c64/cia.h>
+#include "mapgen_api.h"
+#include "mapgen_config.h"
+#include "mapgen_internal.h"
+#include "mapgen_display.h"
+#include "mapgen_progress.h"
+#include "mapgen_bench.h"
+#include "mapgen_raster.h"
+
+// =============================================================================
+// BENCHMARK DATA
+// =============================================================================
+
+#define BENCH_SCREEN ((unsigned char*)SCREEN_MEMORY_BASE)
+
+static const char *bench_size_names[MAP_SIZE_MAX + 1] = {
+    "small",
+    "medium",
+    "large",
+#ifdef MAPGEN_LARGE_MAPS
+    "huge"
+#endif
+};
+
+static const char *bench_phase_names[BENCH_PHASES] = {
+    "rooms",
+    "corridor",
+    "hidden",
+    "niches",
+    "decoys",
+    "passages",
+    "stairs",
+    "populate"
+};
+
+// Per map size: min/avg/max total and phase sums, in cycles
+static unsigned long bench_min[MAP_SIZE_MAX + 1];                   // 12 bytes
+static unsigned long bench_max[MAP_SIZE_MAX + 1];                   // 12 bytes
+static unsigned long bench_sum[MAP_SIZE_MAX + 1];                   // 12 bytes
+static unsigned long bench_phase_sum[MAP_SIZE_MAX + 1][BENCH_PHASES]; // 96 bytes
+
+// Pan benchmark per step kind: count, cycle sum, worst step, steps over a frame
+static const char *bench_pan_names[BENCH_PAN_KINDS] = {
+    "up",
+    "down",
+    "left",
+    "right",
+    "diagonal"
+};
+
+static unsigned int bench_pan_steps[BENCH_PAN_KINDS];               // 10 bytes
+static unsigned long bench_pan_sum[BENCH_PAN_KINDS];                // 20 bytes
+static unsigned long bench_pan_worst[BENCH_PAN_KINDS];              // 20 bytes
+static unsigned int bench_pan_over[BENCH_PAN_KINDS];                // 10 bytes
+
+// Phase being timed (255 = none), its start, and the row it adds to
+static unsigned char bench_phase = 255;
+static unsigned long bench_last;
+static unsigned long *bench_phase_row;
+
+// =============================================================================
+// CIA2 CYCLE COUNTER
+// =============================================================================
+
+// Timer A counts cycles from $FFFF, timer B counts timer A underflows
+static void bench_timer_start(void) {
+    cia2.cra = 0x00;                    // Stop both
+    cia2.crb = 0x00;
+    cia2.icr = 0x03;                    // No NMIs from timer A/B underflows
+    cia2.ta = 0xFFFF;
+    cia2.tb = 0xFFFF;
+    cia2.crb = 0x51;                    // Load, count timer A underflows, start
+    cia2.cra = 0x11;                    // Load, count cycles, start
+}
+
+// Cycles since bench_timer_start(). Timer A is held while both halves
+// are read (B only moves on A underflows), so the pair is consistent.
+static unsigned long bench_cycles(void) {
+    cia2.cra = 0x00;
+    unsigned long count = ((unsigned long)cia2.tb << 16) | cia2.ta;
+    cia2.cra = 0x01;                    // Continue without reload
+    return ~count;
+}
+
+void bench_phase_mark(unsigned char phase) {
+    unsigned long now = bench_cycles();
+    if (bench_phase < BENCH_PHASES) {
+        bench_phase_row[bench_phase] += now - bench_last;
+    }
+    bench_phase = phase;
+    bench_last = now;
+}
+
+// =============================================================================
+// SCREEN OUTPUT
+// =============================================================================
+
+static void bench_print(unsigned char x, unsigned char y, const char *text) {
+    unsigned int offset = y * 40 + x;
+    while (*text) {
+        BENCH_SCREEN[offset++] = *text++;
+    }
+}
+
+// Right-aligned decimal number, width digits (space padded)
+static void bench_number(unsigned char x, unsigned char y, unsigned long value, unsigned char width) {
+    unsigned int offset = y * 40 + x + width;
+    do {
+        BENCH_SCREEN[--offset] = '0' + (unsigned char)(value % 10);
+        value /= 10;
+        width--;
+    } while (value && width);
+    while (width--) {
+        BENCH_SCREEN[--offset] = ' ';
+    }
+}
+
+static void bench_clear(void) {
+    for (unsigned int i = 0; i < 1000; i++) {
+        BENCH_SCREEN[i] = ' ';
+    }
+}
+
+// Cycles to kilocycles (~ms), rounded
+static unsigned long bench_kcycles(unsigned long cycles) {
+    return (cycles + 500) / 1000;
+}
+
+// =============================================================================
+// GENERATION BENCHMARK
+// =============================================================================
+
+void run_generation_benchmark(const MapConfig *config, unsigned int first_seed, unsigned char seeds) {
+    while (!(cia1.pra & 0x10)) {}      // FIRE from the menu released
+
+    bench_clear();
+    bench_print(1, 1, "benchmark");
+    bench_print(1, 3, "size");
+    bench_print(1, 4, "seed");
+
+    progress_muted = 1;
+
+    for (unsigned char size = 0; size <= MAP_SIZE_MAX; size++) {
+        bench_min[size] = 0xFFFFFFFFUL;
+        bench_max[size] = 0;
+        bench_sum[size] = 0;
+        for (unsigned char p = 0; p < BENCH_PHASES; p++) {
+            bench_phase_sum[size][p] = 0;
+        }
+        bench_phase_row = bench_phase_sum[size];
+        bench_print(7, 3, "      ");
+        bench_print(7, 3, bench_size_names[size]);
+
+        unsigned int seed = first_seed;
+        for (unsigned char n = 0; n < seeds; n++) {
+            bench_number(7, 4, seed, 5);
+
+            mapgen_init(seed);
+            bench_phase = 255;
+            bench_timer_start();
+            mapgen_generate_with_params(size, config->hidden_rooms, config->niches, config->deception);
+            unsigned long cycles = bench_cycles();
+
+            if (cycles < bench_min[size]) bench_min[size] = cycles;
+            if (cycles > bench_max[size]) bench_max[size] = cycles;
+            bench_sum[size] += cycles;
+
+            seed = seed < 65535 ? seed + 1 : 1;
+        }
+    }
+
+    progress_muted = 0;
+
+    // Results
+    bench_clear();
+    bench_print(1, 1, "benchmark: ");
+    bench_number(12, 1, seeds, 2);
+    bench_print(15, 1, "seeds from");
+    bench_number(26, 1, first_seed, 5);
+    bench_print(1, 2, "kcycles (~ms)");
+
+    bench_print(1, 4, "size");
+    bench_print(12, 4, "min");
+    bench_print(19, 4, "avg");
+    bench_print(26, 4, "max");
+    for (unsigned char size = 0; size <= MAP_SIZE_MAX; size++) {
+        bench_print(1, 5 + size, bench_size_names[size]);
+        bench_number(9, 5 + size, bench_kcycles(bench_min[size]), 6);
+        bench_number(16, 5 + size, bench_kcycles(bench_sum[size] / seeds), 6);
+        bench_number(23, 5 + size, bench_kcycles(bench_max[size]), 6);
+    }
+
+    bench_print(1, 11, "phase avg");
+    for (unsigned char size = 0; size <= MAP_SIZE_MAX; size++) {
+        bench_print(11 + size * 7, 11, bench_size_names[size]);
+    }
+    for (unsigned char p = 0; p < BENCH_PHASES; p++) {
+        bench_print(1, 12 + p, bench_phase_names[p]);
+        for (unsigned char size = 0; size <= MAP_SIZE_MAX; size++) {
+            bench_number(10 + size * 7, 12 + p, bench_kcycles(bench_phase_sum[size][p] / seeds), 6);
+        }
+    }
+
+    bench_print(13, 23, "fire: back");
+
+    // FIRE press and release
+    while (cia1.pra & 0x10) {}
+    while (!(cia1.pra & 0x10)) {}
+}
+
+// =============================================================================
+// VIEWPORT PAN BENCHMARK
+// =============================================================================
+
+// One scroll step as the navigation loop does it: a diagonal is two
+// move_camera_direction() calls within the same step
+static void bench_pan_step(unsigned char kind, unsigned char direction, unsigned char direction2) {
+    bench_timer_start();
+    move_camera_direction(direction);
+    if (direction2) move_camera_direction(direction2);
+    unsigned long cycles = bench_cycles();
+
+    bench_pan_steps[kind]++;
+    bench_pan_sum[kind] += cycles;
+    if (cycles > bench_pan_worst[kind]) bench_pan_worst[kind] = cycles;
+    if (cycles > BENCH_FRAME_CYCLES) bench_pan_over[kind]++;
+}
+
+void run_pan_benchmark(void) {
+    const unsigned char max_x = current_params.map_width > VIEW_W ? current_params.map_width - VIEW_W : 0;
+    const unsigned char max_y = current_params.map_height > VIEW_H ? current_params.map_height - VIEW_H : 0;
+
+    for (unsigned char k = 0; k < BENCH_PAN_KINDS; k++) {
+        bench_pan_steps[k] = 0;
+        bench_pan_sum[k] = 0;
+        bench_pan_worst[k] = 0;
+        bench_pan_over[k] = 0;
+    }
+
+    // Top-left corner, full redraw
+    camera_center_x = 0;
+    camera_center_y = 0;
+    update_camera();
+    render_map_viewport(1);
+
+    // Serpentine: a horizontal pass to the far edge, then one screen
+    // height down - diagonally back toward the next pass while there is
+    // room, straight down for the rest
+    unsigned char rightward = 1;
+    for (;;) {
+        if (rightward) {
+            while (view.x < max_x) bench_pan_step(BENCH_PAN_RIGHT, MOVE_RIGHT, 0);
+        } else {
+            while (view.x > 0) bench_pan_step(BENCH_PAN_LEFT, MOVE_LEFT, 0);
+        }
+        if (view.y >= max_y) break;
+
+        unsigned char down = max_y - view.y;
+        if (down > VIEW_H) down = VIEW_H;
+        while (down--) {
+            if (rightward ? view.x > 0 : view.x < max_x) {
+                bench_pan_step(BENCH_PAN_DIAGONAL, MOVE_DOWN, rightward ? MOVE_LEFT : MOVE_RIGHT);
+            } else {
+                bench_pan_step(BENCH_PAN_DOWN, MOVE_DOWN, 0);
+            }
+        }
+        rightward = !rightward;
+    }
+
+    // And straight back up
+    while (view.y > 0) bench_pan_step(BENCH_PAN_UP, MOVE_UP, 0);
+
+    // Results in raster lines
+    bench_clear();
+    bench_print(1, 1, "pan benchmark: raster lines per step");
+    bench_print(1, 2, "frame = ");
+    bench_number(9, 2, BENCH_FRAME_LINES, 3);
+    bench_print(13, 2, "lines (pal)");
+
+    bench_print(1, 4, "step");
+    bench_print(12, 4, "steps");
+    bench_print(20, 4, "avg");
+    bench_print(25, 4, "worst");
+    bench_print(31, 4, ">frame");
+    for (unsigned char k = 0; k < BENCH_PAN_KINDS; k++) {
+        unsigned int steps = bench_pan_steps[k];
+        bench_print(1, 5 + k, bench_pan_names[k]);
+        bench_number(12, 5 + k, steps, 5);
+        bench_number(18, 5 + k, steps ? bench_pan_sum[k] / steps / BENCH_LINE_CYCLES : 0, 5);
+        bench_number(25, 5 + k, bench_pan_worst[k] / BENCH_LINE_CYCLES, 5);
+        bench_number(32, 5 + k, bench_pan_over[k], 5);
+    }
+
+    bench_print(13, 23, "fire: back");
+
+    // FIRE press and release, then the map again
+    while (cia1.pra & 0x10) {}
+    while (!(cia1.pra & 0x10)) {}
+    render_map_viewport(1);
+}
+
+#ifdef MAPGEN_RASTER_TIMING
+// =============================================================================
+// RASTER TIMING LEGEND
+// =============================================================================
+
+#define BENCH_COLOUR_RAM ((unsigned char*)0xD800)
+#define BENCH_TEXT_COLOUR (*(volatile unsigned char *)0x0286)
+
+enum MapgenBenchLegendConstants {
+    BENCH_LEGEND_ENTRIES = 12,
+    BENCH_LEGEND_X = 1,
+    BENCH_LEGEND_Y = 1
+};
+
+static const unsigned char bench_legend_colours[BENCH_LEGEND_ENTRIES] = {
+    RASTER_ROOMS, RASTER_CORRIDORS, RASTER_HIDDEN, RASTER_NICHES,
+    RASTER_DECOYS, RASTER_PASSAGES, RASTER_STAIRS, RASTER_POPULATE,
+    RASTER_REDRAW, RASTER_SHIFT, RASTER_FILL, RASTER_PROGRESS
+};
+
+static const char *bench_legend_names[BENCH_LEGEND_ENTRIES] = {
+    "rooms",
+    "corridors",
+    "hidden rooms",
+    "niches",
+    "decoys",
+    "passages",
+    "stairs",
+    "populate",
+    "render: redraw",
+    "render: shift",
+    "render: fill",
+    "progress irq"
+};
+
+void show_raster_legend(void) {
+    // Box over the top left of the map: title, then a colour block and
+    // name per entry (border colour = block colour)
+    for (unsigned char y = 0; y < BENCH_LEGEND_ENTRIES + 3; y++) {
+        bench_print(BENCH_LEGEND_X - 1, BENCH_LEGEND_Y - 1 + y, "                       ");
+    }
+    bench_print(BENCH_LEGEND_X, BENCH_LEGEND_Y, "border colours");
+
+    for (unsigned char i = 0; i < BENCH_LEGEND_ENTRIES; i++) {
+        unsigned char y = BENCH_LEGEND_Y + 2 + i;
+        unsigned int offset = y * 40 + BENCH_LEGEND_X;
+        BENCH_SCREEN[offset] = 0xA0;    // Reverse space
+        BENCH_COLOUR_RAM[offset] = bench_legend_colours[i];
+        bench_print(BENCH_LEGEND_X + 2, y, bench_legend_names[i]);
+    }
+
+    // FIRE press and release, then the map again
+    while (cia1.pra & 0x10) {}
+    while (!(cia1.pra & 0x10)) {}
+
+    for (unsigned char i = 0; i < BENCH_LEGEND_ENTRIES; i++) {
+        BENCH_COLOUR_RAM[(BENCH_LEGEND_Y + 2 + i) * 40 + BENCH_LEGEND_X] = BENCH_TEXT_COLOUR;
+    }
+    render_map_viewport(1);
+}
+#endif
+
+#endif // DEBUG_MAPGEN
@@ -0,0 +1,89 @@
+// =============================================================================
+// Map Generator Benchmark Module
+// =============================================================================
+// DEBUG-only on-target timing: generates a run of consecutive seeds per
+// map size with the progress display muted and reports min/avg/max
+// generation time and the average time of each generation phase.
+//
+// The pan benchmark scrolls the current map in a serpentine over its
+// whole area (including diagonal steps) and reports the raster lines
+// each scroll step took: average, worst, and steps longer than a frame.
+//
+// Time comes from CIA2 timers A and B cascaded into a 32-bit cycle
+// counter (~985 cycles per ms on PAL), so it includes badline DMA and
+// IRQs - the time a player actually waits. Generation times are shown
+// in kilocycles (roughly milliseconds), scroll steps in raster lines.
+//
+// With MAPGEN_RASTER_TIMING the legend of the border colours
+// (mapgen_raster.h) is shown over the map.
+//
+// Only compiled when DEBUG_MAPGEN is defined.
+// =============================================================================
+
+#ifndef MAPGEN_BENCH_H
+#define MAPGEN_BENCH_H
+
+#ifdef DEBUG_MAPGEN
+
+#include "mapgen_config.h"
+
+enum MapgenBenchConstants {
+    BENCH_PHASES = 8,                   // Generation phases 0-7 (show_phase ids)
+    BENCH_LINE_CYCLES = 63,             // PAL cycles per raster line
+    BENCH_FRAME_LINES = 312             // PAL raster lines per frame
+};
+
+#define BENCH_FRAME_CYCLES  ((unsigned long)BENCH_LINE_CYCLES * BENCH_FRAME_LINES)
+
+// Pan benchmark step kinds
+enum MapgenBenchPanKinds {
+    BENCH_PAN_UP,
+    BENCH_PAN_DOWN,
+    BENCH_PAN_LEFT,
+    BENCH_PAN_RIGHT,
+    BENCH_PAN_DIAGONAL,                 // Down plus left or right
+    BENCH_PAN_KINDS
+};
+
+// =============================================================================
+// BENCHMARK FUNCTIONS
+// =============================================================================
+
+/**
+ * @brief Record the start of a generation phase while the progress is muted
+ * @param phase Phase index (0-8, 8 = generation complete)
+ *
+ * Called by show_phase(); the time since the previous mark is added to
+ * the previous phase.
+ */
+void bench_phase_mark(unsigned char phase);
+
+/**
+ * @brief Time a run of seeds for every map size and show the results
+ * @param config Hidden room, niche and deception presets to use
+ * @param first_seed First seed of the run
+ * @param seeds Seeds per map size
+ *
+ * Waits for FIRE on the results screen before it returns.
+ */
+void run_generation_benchmark(const MapConfig *config, unsigned int first_seed, unsigned char seeds);
+
+/**
+ * @brief Pan the current map in a serpentine and show scroll step costs
+ *
+ * Waits for FIRE on the results screen, then redraws the map.
+ */
+void run_pan_benchmark(void);
+
+#ifdef MAPGEN_RASTER_TIMING
+/**
+ * @brief Show the border colour legend over the map (MAPGEN_RASTER_TIMING)
+ *
+ * Waits for FIRE, then redraws the map.
+ */
+void show_raster_legend(void);
+#endif
+
+#endif // DEBUG_MAPGEN
+
+#endif // MAPGEN_BENCH_H
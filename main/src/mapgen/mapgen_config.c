@@ -14,18 +14,24 @@
 // =============================================================================
 
 // Map size table (width, height) - optimized for consistent 14×14 grid cells
-const unsigned char map_size_table[3][2] = {
+const unsigned char map_size_table[MAP_SIZE_MAX + 1][2] = {
     {50, 50},  // SMALL: 3×14+8=50
     {64, 64},  // MEDIUM: 4×14+8=64
-    {78, 78}   // LARGE: 5×14+8=78
+    {78, 78},  // LARGE: 5×14+8=78
+#ifdef MAPGEN_LARGE_MAPS
+    {128, 128} // HUGE: 8×15+8=128 (chunked map storage)
+#endif
 };
 
 // Grid size table - determines max rooms per map size
-// SMALL: 3×3=9, MEDIUM: 4×4=16, LARGE: 5×5=25 (clamped to MAX_ROOMS=20)
-const unsigned char grid_size_table[3] = {
+// SMALL: 3×3=9, MEDIUM: 4×4=16, LARGE: 5×5=25
+const unsigned char grid_size_table[MAP_SIZE_MAX + 1] = {
     3,   // SMALL: 3×3 = 9 rooms
     4,   // MEDIUM: 4×4 = 16 rooms
-    5    // LARGE: 5×5 = 20 rooms (clamped)
+    5,   // LARGE: 5×5 = 25 rooms
+#ifdef MAPGEN_LARGE_MAPS
+    8    // HUGE: 8×8 = 64 rooms
+#endif
 };
 
 // Feature ratios (percentage-based)
@@ -49,7 +55,7 @@ void validate_and_adjust_config(MapConfig *config, MapParameters *params) {
     params->map_width = map_size_table[config->map_size][0];
     params->map_height = map_size_table[config->map_size][1];
 
-    // Grid size determines max rooms (3×3=9, 4×4=16, 5×5=20 clamped to MAX_ROOMS)
+    // Grid size determines max rooms (3×3=9, 4×4=16, 5×5=25, clamped to MAX_ROOMS)
     params->grid_size = grid_size_table[config->map_size];
     params->max_rooms = params->grid_size * params->grid_size;
     if (params->max_rooms > MAX_ROOMS) {
@@ -14,7 +14,13 @@
 typedef enum {
     LEVEL_SMALL = 0,
     LEVEL_MEDIUM = 1,
-    LEVEL_LARGE = 2
+    LEVEL_LARGE = 2,
+#ifdef MAPGEN_LARGE_MAPS
+    LEVEL_HUGE = 3,             // Map size only: 128×128, 8×8 grid
+    MAP_SIZE_MAX = LEVEL_HUGE
+#else
+    MAP_SIZE_MAX = LEVEL_LARGE
+#endif
 } PresetLevel;
 
 // Main configuration structure (user-facing settings)
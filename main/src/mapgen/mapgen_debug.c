@@ -17,6 +17,7 @@
 #include "mapgen_config.h"
 #include "mapgen_display.h"
 #include "map_export.h"
+#include "mapgen_bench.h"
 
 // =============================================================================
 // DEBUG-ONLY DATA
@@ -26,10 +27,13 @@
 #define SCREEN_RAM ((unsigned char*)0x0400)
 
 // Display strings for different setting types
-static const char *size_names[3] = {
+static const char *size_names[MAP_SIZE_MAX + 1] = {
     "small ",
     "medium",
-    "large "
+    "large ",
+#ifdef MAPGEN_LARGE_MAPS
+    "huge  "
+#endif
 };
 
 static const char *percent_names[3] = {
@@ -38,8 +42,8 @@ static const char *percent_names[3] = {
     "50%   "
 };
 
-// Menu line to screen row mapping (5 items: 4 settings + seed)
-static const unsigned char menu_rows[5] = {5, 7, 9, 11, 13};
+// Menu line to screen row mapping (6 items: 4 settings + seed + benchmark)
+static const unsigned char menu_rows[6] = {5, 7, 9, 11, 13, 15};
 
 // Setting type for each menu item (0=size, 1=percent)
 static const unsigned char setting_types[4] = {0, 1, 1, 1};
@@ -47,6 +51,10 @@ static const unsigned char setting_types[4] = {0, 1, 1, 1};
 // Current seed value (0 = random)
 static unsigned int menu_seed = 0;
 
+// Benchmark seeds per map size (menu choice)
+static const unsigned char bench_seed_counts[4] = {8, 16, 32, 64};
+static unsigned char bench_count_index = 1;
+
 // =============================================================================
 // DEBUG-ONLY CONFIGURATION FUNCTIONS
 // =============================================================================
@@ -227,15 +235,9 @@ static void update_value(unsigned char menu_item, PresetLevel value) {
 // =============================================================================
 
 /**
- * @brief Show configuration menu and allow user to adjust settings
+ * @brief Draw the configuration menu with current values and cursor
  */
-static void show_config_menu(MapConfig *config) {
-    unsigned char cursor = 0;
-    unsigned char done = 0;
-    unsigned char old_cursor;
-    unsigned char joy2, prev_joy2 = 0xFF;
-
-    // Initial screen setup - draw once
+static void draw_config_menu(const MapConfig *config, unsigned char cursor) {
     clear_screen();
 
     // Title - centered (lowercase for normal display in mixed charset)
@@ -248,6 +250,7 @@ static void show_config_menu(MapConfig *config) {
     print_at(7, 9, "niches");
     print_at(7, 11, "deception");
     print_at(7, 13, "seed");
+    print_at(7, 15, "benchmark");
 
     // Initial values - use menu item index (0-3) for correct display type
     update_value(0, config->map_size);
@@ -255,15 +258,29 @@ static void show_config_menu(MapConfig *config) {
     update_value(2, config->niches);
     update_value(3, config->deception);
 
-    // Seed value (0 = random)
+    // Seed value (0 = random), benchmark seeds per map size
     print_seed_value(13, menu_seed);
+    print_seed_value(15, bench_seed_counts[bench_count_index]);
 
     // Instructions - centered
     print_at(10, 21, "joy2: navigation");
     print_at(8, 23, "fire: start  seed 0=rnd");
 
-    // Initial cursor (first menu item at row 5, column 6)
-    SCREEN_RAM[5 * 40 + 6] = '>';
+    // Cursor at column 6
+    SCREEN_RAM[menu_rows[cursor] * 40 + 6] = '>';
+}
+
+/**
+ * @brief Show configuration menu and allow user to adjust settings
+ */
+static void show_config_menu(MapConfig *config) {
+    unsigned char cursor = 0;
+    unsigned char done = 0;
+    unsigned char old_cursor;
+    unsigned char joy2, prev_joy2 = 0xFF;
+
+    // Initial screen setup - draw once
+    draw_config_menu(config, cursor);
 
     while (!done) {
         // Read joystick 2 from CIA1 Port A
@@ -278,8 +295,8 @@ static void show_config_menu(MapConfig *config) {
                 cursor--;
                 update_cursor(old_cursor, cursor);
             }
-            // Navigation - DOWN (5 menu items: 0-4)
-            else if (!(joy2 & 0x02) && cursor < 4) {
+            // Navigation - DOWN (6 menu items: 0-5)
+            else if (!(joy2 & 0x02) && cursor < 5) {
                 cursor++;
                 update_cursor(old_cursor, cursor);
             }
@@ -289,6 +306,12 @@ static void show_config_menu(MapConfig *config) {
                     // Seed selected - enter numeric input mode
                     menu_seed = input_seed_value();
                     print_seed_value(13, menu_seed);
+                } else if (cursor == 5) {
+                    // Benchmark from the menu seed (0 = seed 1), then back
+                    run_generation_benchmark(config, menu_seed ? menu_seed : 1,
+                                             bench_seed_counts[bench_count_index]);
+                    draw_config_menu(config, cursor);
+                    joy2 = cia1.pra;
                 } else {
                     // Start generation
                     done = 1;
@@ -299,7 +322,7 @@ static void show_config_menu(MapConfig *config) {
             if (!(joy2 & 0x08)) {
                 switch (cursor) {
                     case 0:
-                        if (config->map_size < LEVEL_LARGE) {
+                        if (config->map_size < MAP_SIZE_MAX) {
                             config->map_size++;
                             update_value(0, config->map_size);
                         }
@@ -322,6 +345,12 @@ static void show_config_menu(MapConfig *config) {
                             update_value(3, config->deception);
                         }
                         break;
+                    case 5:
+                        if (bench_count_index < 3) {
+                            bench_count_index++;
+                            print_seed_value(15, bench_seed_counts[bench_count_index]);
+                        }
+                        break;
                 }
             }
             // Value adjustment - LEFT (decrease)
@@ -351,6 +380,12 @@ static void show_config_menu(MapConfig *config) {
                             update_value(3, config->deception);
                         }
                         break;
+                    case 5:
+                        if (bench_count_index > 0) {
+                            bench_count_index--;
+                            print_seed_value(15, bench_seed_counts[bench_count_index]);
+                        }
+                        break;
                 }
             }
 
@@ -412,6 +447,12 @@ void mapgen_run_debug_mode(void) {
             break;
         } else if (key == 'M' || key == 'm') {
             save_map_seed("mapbin");
+        } else if (key == 'P' || key == 'p') {
+            run_pan_benchmark();
+#ifdef MAPGEN_RASTER_TIMING
+        } else if (key == 'C' || key == 'c') {
+            show_raster_legend();
+#endif
         } else if (key == 'L' || key == 'l') {
             if (load_map_seed("mapbin", &config)) {
                 // Load successful - regenerate with loaded settings
@@ -5,6 +5,7 @@
 // - Interactive configuration menu with joystick controls
 // - Map preview and navigation
 // - Real-time regeneration with FIRE button
+// - Generation benchmark menu entry and pan benchmark ('P', mapgen_bench.h)
 // - Map export functionality ('M' key)
 //
 // Only compiled when DEBUG_MAPGEN is defined.
@@ -36,6 +37,8 @@
  * - Joystick 2 UP/DOWN/LEFT/RIGHT: Navigate map viewport
  * - FIRE button: Show menu and regenerate map
  * - 'M' key: Export map to disk
+ * - 'P' key: Viewport pan benchmark
+ * - 'C' key: Border colour legend (MAPGEN_RASTER_TIMING builds)
  * - 'Q' key: Quit and return to BASIC
  *
  * @note This function only exists when DEBUG_MAPGEN is defined.
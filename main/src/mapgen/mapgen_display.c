@@ -14,6 +14,7 @@
 #include "mapgen_utils.h"         // For viewport utilities, tile access, helper functions
 #include "mapgen_display.h"       // For display, viewport, input
 #include "mapgen_config.h"        // For MapParameters
+#include "mapgen_raster.h"        // For RASTER_MARK (MAPGEN_RASTER_TIMING only)
 
 // External reference to current generation parameters
 extern MapParameters current_params;
@@ -180,7 +181,9 @@ void update_full_screen(void) {
     unsigned char screen_y, x;
     unsigned short screen_pos;
     unsigned char tile;
-    
+
+    RASTER_MARK(RASTER_REDRAW);
+
     // Update all 25 rows
     for (screen_y = 0; screen_y < VIEW_H; screen_y++) {
         screen_pos = screen_y * 40;  // Calculate screen memory offset
@@ -223,6 +226,8 @@ void render_map_viewport(unsigned char force_refresh) {
         update_full_screen();
     }
     
+    RASTER_MARK(RASTER_IDLE);
+
     // Clear dirty flag
     screen_dirty = 0;
     last_scroll_direction = 0;
@@ -331,6 +336,7 @@ void update_partial_screen(unsigned char scroll_dir) {
         case 1: 
         // Scroll UP - move content down by one line only
         // Shift screen content down by 1 line
+        RASTER_MARK(RASTER_SHIFT);
         for (y = max_y; y >= 1; y--) {
             // Shift this line in screen memory
             for (x = 0; x < VIEW_W; x++) {
@@ -340,6 +346,7 @@ void update_partial_screen(unsigned char scroll_dir) {
             memmove(&screen_buffer[y][0], &screen_buffer[y - 1][0], VIEW_W);
         }
         // Fill top line with new content
+        RASTER_MARK(RASTER_FILL);
         for (x = 0; x < VIEW_W; x++) {
             unsigned char tile = get_map_tile(view.x + x, view.y);
             screen_memory[0 * 40 + x] = tile;
@@ -349,7 +356,8 @@ void update_partial_screen(unsigned char scroll_dir) {
         
         case 2: 
         // Scroll DOWN - move content up by one line only
-        // Shift screen content up by 1 line  
+        // Shift screen content up by 1 line
+        RASTER_MARK(RASTER_SHIFT);
         for (y = 0; y < max_y; y++) {
             // Shift this line in screen memory
             for (x = 0; x < VIEW_W; x++) {
@@ -359,6 +367,7 @@ void update_partial_screen(unsigned char scroll_dir) {
             memmove(&screen_buffer[y][0], &screen_buffer[y + 1][0], VIEW_W);
         }
         // Fill bottom line with new content
+        RASTER_MARK(RASTER_FILL);
         screen_offset = max_y * 40;
         for (x = 0; x < VIEW_W; x++) {
             unsigned char tile = get_map_tile(view.x + x, view.y + max_y);
@@ -371,12 +380,14 @@ void update_partial_screen(unsigned char scroll_dir) {
         // Scroll LEFT - move content right by one column only
         // Shift screen content right by 1 column
         for (y = 0; y < VIEW_H; y++) {
+            RASTER_MARK(RASTER_SHIFT);
             for (x = max_x; x >= 1; x--) {
                 screen_memory[y * 40 + x] = screen_memory[y * 40 + x - 1];
             }
             // Shift buffer content
             memmove(&screen_buffer[y][1], &screen_buffer[y][0], max_x);
             // Fill leftmost column
+            RASTER_MARK(RASTER_FILL);
             unsigned char tile = get_map_tile(view.x, view.y + y);
             screen_memory[y * 40] = tile;
             screen_buffer[y][0] = tile;
@@ -387,12 +398,14 @@ void update_partial_screen(unsigned char scroll_dir) {
         // Scroll RIGHT - move content left by one column only
         // Shift screen content left by 1 column
         for (y = 0; y < VIEW_H; y++) {
+            RASTER_MARK(RASTER_SHIFT);
             for (x = 0; x < max_x; x++) {
                 screen_memory[y * 40 + x] = screen_memory[y * 40 + x + 1];
             }
             // Shift buffer content
             memmove(&screen_buffer[y][0], &screen_buffer[y][1], max_x);
             // Fill rightmost column
+            RASTER_MARK(RASTER_FILL);
             unsigned char tile = get_map_tile(view.x + max_x, view.y + y);
             screen_memory[y * 40 + max_x] = tile;
             screen_buffer[y][max_x] = tile;
@@ -12,6 +12,9 @@
 void create_rooms(void);
 void build_room_network(void);
 void add_stairs(void);
+void select_stair_rooms(unsigned char *up_room, unsigned char *down_room);
+void populate_rooms(void);
+unsigned char generate_layout(void);
 unsigned char generate_level(void);
 void place_room(unsigned char x, unsigned char y, unsigned char w, unsigned char h);
 
@@ -36,6 +39,10 @@ void place_hidden_passages(unsigned char passage_count);
 extern unsigned char compact_map[COMPACT_MAP_SIZE];
 extern Room room_list[MAX_ROOMS];
 extern unsigned char room_count;
+
+// Placement grid (defined in room_management.c, valid during generation)
+extern unsigned char grid_room[MAX_GRID_SIZE * MAX_GRID_SIZE];  // Room in each cell or 255
+extern unsigned char room_grid_cell[MAX_ROOMS];                 // Cell of each room
 extern unsigned char rnd_state;
 
 // Generation parameters (defined in map_generation.c)
@@ -47,6 +54,25 @@ extern unsigned char total_hidden_rooms;     // Hidden rooms placed
 extern unsigned char total_niches;           // Wall niches placed
 extern unsigned char total_decoys;           // Decoy corridors placed
 extern unsigned char available_walls_count;  // Walls without doors
+extern MapgenStats mapgen_stats;             // Retries and rejections per phase
+
+// Stair rooms (defined in map_generation.c, 255 = none)
+extern unsigned char stairs_up_room;
+extern unsigned char stairs_down_room;
+
+// Walk lengths from the up stairs room (defined in map_generation.c,
+// set by select_stair_rooms, remeasured when a level is restored)
+#define STAIRS_NO_DISTANCE 0xFFFF                   // Room not reached
+extern unsigned int stairs_room_distance[MAX_ROOMS]; // To each room centre
+extern unsigned int stairs_path_length;             // To the down stairs
+
+// Fill stairs_room_distance[] from up_room and stairs_path_length to
+// down_room (255 = none)
+void measure_stair_walks(unsigned char up_room, unsigned char down_room);
+
+// Up stairs pin (defined in map_generation.c, 255 = none)
+extern unsigned char stairs_pin_x, stairs_pin_y;
+extern unsigned char stairs_pin_room;               // Room centred on the pin
 
 // Zero page variables for MST performance
 extern __zeropage unsigned char mst_best_room1;
@@ -79,6 +105,21 @@ unsigned char can_place_corridor(unsigned char x, unsigned char y, unsigned char
 // ROOM CONNECTION FUNCTIONS
 // =============================================================================
 
+/**
+ * @brief Compute bend points of a corridor between two doors
+ * @param start_x, start_y Door the corridor was drawn from
+ * @param end_x, end_y Door at the other end
+ * @param wall_side Wall side of the start door
+ * @param corridor_type 0=straight, 1=L-shaped, 2=Z-shaped
+ * @param out Receives bend points in drawing order
+ *
+ * Deterministic - the same inputs give the tiles that were carved.
+ */
+void compute_corridor_breakpoints(unsigned char start_x, unsigned char start_y,
+                                  unsigned char end_x, unsigned char end_y,
+                                  unsigned char wall_side, unsigned char corridor_type,
+                                  CorridorBreakpoints *out);
+
 
 // =============================================================================
 // DOOR PLACEMENT FUNCTIONS
@@ -0,0 +1,103 @@
+// =============================================================================
+// MAPGEN OVERLAY - Generator Code Paged In Only for Level Transitions
+// Implementation - Oscar64 Optimized
+// =============================================================================
+
+#include <c64/kernalio.h>
+#include "mapgen_overlay.h"
+#include "overlay_loader.h"
+#include "mapgen_api.h"
+
+// =============================================================================
+// OVERLAY HEADER (first bytes of the overlay region)
+// =============================================================================
+
+unsigned char ovl_mapgen_generate_dungeon(void);
+unsigned char ovl_mapgen_generate_with_params(unsigned char map_size, unsigned char hidden_rooms,
+                                              unsigned char niches, unsigned char deception);
+unsigned char ovl_mapgen_generate_dungeon_set(unsigned int master_seed, unsigned char depth);
+
+#pragma data(mgjump)
+
+const MapgenOverlayHeader mapgen_overlay_header = {
+    { MAPGEN_OVERLAY_MAGIC_0, MAPGEN_OVERLAY_MAGIC_1 },
+    MAPGEN_OVERLAY_VERSION,
+    MAPGEN_OVERLAY_ENTRIES,
+    {
+        { MAPGEN_OVERLAY_JMP, (void (*)(void))ovl_mapgen_generate_dungeon },
+        { MAPGEN_OVERLAY_JMP, (void (*)(void))ovl_mapgen_generate_with_params },
+        { MAPGEN_OVERLAY_JMP, (void (*)(void))ovl_mapgen_generate_dungeon_set }
+    }
+};
+
+#pragma data(data)
+
+// Entry signatures, called at the JMP of their slot
+typedef unsigned char (*MapgenGenerateFn)(void);
+typedef unsigned char (*MapgenGenerateParamsFn)(unsigned char, unsigned char, unsigned char, unsigned char);
+typedef unsigned char (*MapgenGenerateSetFn)(unsigned int, unsigned char);
+
+#define MAPGEN_OVERLAY_SLOT(index)  ((void *)&MAPGEN_OVERLAY_HEADER->entry[index])
+
+// =============================================================================
+// OVERLAY FUNCTIONS
+// =============================================================================
+
+unsigned char mapgen_overlay_present(void) {
+    volatile MapgenOverlayHeader *header = MAPGEN_OVERLAY_HEADER;
+    return header->magic[0] == MAPGEN_OVERLAY_MAGIC_0 &&
+           header->magic[1] == MAPGEN_OVERLAY_MAGIC_1 &&
+           header->version == MAPGEN_OVERLAY_VERSION &&
+           header->entry_count >= MAPGEN_OVERLAY_ENTRIES;
+}
+
+unsigned char mapgen_overlay_park(void) {
+    return overlay_park(MAPGEN_OVERLAY_PACKED);
+}
+
+// Accept a load attempt only if it completed and the header checks out.
+// A failed attempt may have written the header before its code: clear
+// the magic again so the generate stubs refuse to jump into it.
+static unsigned char mapgen_overlay_loaded(unsigned char ok) {
+    if (ok && mapgen_overlay_present()) return 1;
+    mapgen_overlay_release();
+    return 0;
+}
+
+unsigned char mapgen_overlay_load(void) {
+    if (mapgen_overlay_present()) return 1;
+    mapgen_overlay_release();
+
+    // Fastest first: parked in RAM, packed file, plain file
+    if (mapgen_overlay_loaded(overlay_unpark())) return 1;
+    if (mapgen_overlay_loaded(overlay_load(MAPGEN_OVERLAY_PACKED))) return 1;
+
+    // Secondary address 1: the overlay file carries its own load address
+    krnio_setnam(MAPGEN_OVERLAY_FILE);
+    return mapgen_overlay_loaded(krnio_load(1, MAPGEN_OVERLAY_DEVICE, 1));
+}
+
+void mapgen_overlay_release(void) {
+    MAPGEN_OVERLAY_HEADER->magic[0] = 0;
+}
+
+// =============================================================================
+// RESIDENT API STUBS
+// =============================================================================
+
+unsigned char mapgen_generate_dungeon(void) {
+    if (!mapgen_overlay_present()) return 0;
+    return ((MapgenGenerateFn)MAPGEN_OVERLAY_SLOT(MAPGEN_ENTRY_GENERATE_DUNGEON))();
+}
+
+unsigned char mapgen_generate_with_params(unsigned char map_size, unsigned char hidden_rooms,
+                                          unsigned char niches, unsigned char deception) {
+    if (!mapgen_overlay_present()) return 2;
+    return ((MapgenGenerateParamsFn)MAPGEN_OVERLAY_SLOT(MAPGEN_ENTRY_GENERATE_WITH_PARAMS))(
+        map_size, hidden_rooms, niches, deception);
+}
+
+unsigned char mapgen_generate_dungeon_set(unsigned int master_seed, unsigned char depth) {
+    if (!mapgen_overlay_present()) return 0;
+    return ((MapgenGenerateSetFn)MAPGEN_OVERLAY_SLOT(MAPGEN_ENTRY_GENERATE_DUNGEON_SET))(master_seed, depth);
+}
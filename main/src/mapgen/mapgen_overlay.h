@@ -0,0 +1,135 @@
+#ifndef MAPGEN_OVERLAY_H
+#define MAPGEN_OVERLAY_H
+
+// =============================================================================
+// MAPGEN OVERLAY - Generator Code Paged In Only for Level Transitions
+// =============================================================================
+//
+// Build with -dMAPGEN_OVERLAY (build-mapgen-overlay.bat). The generator
+// code (map_generation, room_management, connection_system, the two
+// generate entry points and dungeon set planning) is then compiled into the Oscar64 overlay
+// "MAPGEN", a separate file linked for MAPGEN_OVERLAY_BASE.
+//
+// Everything else stays resident below the overlay: tile access, TMEA,
+// the runtime modules, the two corridor helpers room_path needs at game
+// time (get_connection_info, compute_corridor_breakpoints) and ALL data - compact_map, room_list, room_count,
+// current_params and every generator variable live in the main region,
+// so the game reads a generated level in place after the overlay RAM has
+// been handed to the engine.
+//
+// The overlay starts with a fixed header and jump table. Resident code
+// calls mapgen_generate_dungeon() / mapgen_generate_with_params() as
+// before; those are stubs that check the header magic and jump through
+// the table, so a missing or released overlay is an error return, not a
+// crash. Only those generate entry points need the overlay loaded:
+// state-only API calls (mapgen_init, mapgen_set_depth, ...) and all
+// gameplay code, room pathfinding included, run with it paged out -
+// streaming a level pack works too.
+//
+// Overlay layout at MAPGEN_OVERLAY_BASE:
+// +0  'M' 'G' version entry_count
+// +4  JMP entry 0, JMP entry 1, ...    (3 bytes each, MapgenOverlayEntries)
+// +n  generator code
+//
+// Memory: ~9KB of generator code moves to the overlay region
+//
+// =============================================================================
+
+#ifdef DEBUG_MAPGEN
+#ifdef MAPGEN_OVERLAY
+#error "MAPGEN_OVERLAY is a RELEASE build option (DEBUG calls generator internals)"
+#endif
+#endif
+
+// Overlay region (configurable load address, -dMAPGEN_OVERLAY_BASE=...)
+#ifndef MAPGEN_OVERLAY_BASE
+#define MAPGEN_OVERLAY_BASE     0x7800
+#endif
+#ifndef MAPGEN_OVERLAY_END
+#define MAPGEN_OVERLAY_END      0xA000  // Level cache starts here
+#endif
+
+#define MAPGEN_OVERLAY_MAGIC_0  'M'
+#define MAPGEN_OVERLAY_MAGIC_1  'G'
+#define MAPGEN_OVERLAY_VERSION  1
+
+#define MAPGEN_OVERLAY_FILE     "MAPGEN"
+#define MAPGEN_OVERLAY_PACKED   "MAPGEN.LZ"     // tools/ovlpack output
+
+enum MapgenOverlayConstants {
+    MAPGEN_OVERLAY_DEVICE = 8,
+    MAPGEN_OVERLAY_JMP = 0x4C           // 6502 JMP absolute
+};
+
+// Jump table slots - append only, existing numbers never move
+enum MapgenOverlayEntries {
+    MAPGEN_ENTRY_GENERATE_DUNGEON,      // unsigned char (void)
+    MAPGEN_ENTRY_GENERATE_WITH_PARAMS,  // unsigned char (size, hidden, niches, deception)
+    MAPGEN_ENTRY_GENERATE_DUNGEON_SET,  // unsigned char (master_seed, depth)
+    MAPGEN_OVERLAY_ENTRIES
+};
+
+typedef struct {
+    unsigned char jmp;                  // MAPGEN_OVERLAY_JMP
+    void (*target)(void);
+} MapgenOverlayJump;
+
+// Header at MAPGEN_OVERLAY_BASE (4 + 3 * entries bytes)
+typedef struct {
+    unsigned char magic[2];
+    unsigned char version;
+    unsigned char entry_count;
+    MapgenOverlayJump entry[MAPGEN_OVERLAY_ENTRIES];
+} MapgenOverlayHeader;
+
+#define MAPGEN_OVERLAY_HEADER   ((volatile MapgenOverlayHeader *)MAPGEN_OVERLAY_BASE)
+
+// Generate entry points: overlay implementations get an ovl_ prefix and
+// the public names become the resident stubs
+#ifdef MAPGEN_OVERLAY
+#define MAPGEN_ENTRY(name)      ovl_##name
+#else
+#define MAPGEN_ENTRY(name)      name
+#endif
+
+#ifdef MAPGEN_OVERLAY
+// =============================================================================
+// OVERLAY FUNCTIONS (resident)
+// =============================================================================
+
+/**
+ * @brief Bring the generator overlay in and check its header
+ * @return 1 if the overlay is ready, 0 on disk error or wrong version
+ *
+ * Tries the parked copy, then MAPGEN.LZ (decoded while it loads), then
+ * the plain MAPGEN file. The header magic is cleared before the first
+ * attempt and after every failed one, so it is only valid once a load
+ * has completed.
+ */
+unsigned char mapgen_overlay_load(void);
+
+/**
+ * @brief Read the packed generator overlay into the park area
+ * @return 1 on success, 0 on disk error
+ *
+ * For the intro: the disk runs while IRQ music keeps playing, and the
+ * next mapgen_overlay_load() decodes from RAM (see overlay_loader.h).
+ */
+unsigned char mapgen_overlay_park(void);
+
+/**
+ * @brief Check whether the generator overlay is in memory
+ * @return 1 if the header at MAPGEN_OVERLAY_BASE is valid
+ */
+unsigned char mapgen_overlay_present(void);
+
+/**
+ * @brief Give the overlay RAM to the engine
+ *
+ * Clears the header magic so generate calls fail cleanly until the next
+ * mapgen_overlay_load(). All level data stays valid.
+ */
+void mapgen_overlay_release(void);
+#endif
+
+#endif // MAPGEN_OVERLAY_H
@@ -14,6 +14,8 @@
 #include "mapgen_types.h"
 #include "mapgen_config.h"
 #include "mapgen_progress.h"
+#include "mapgen_bench.h"
+#include "mapgen_raster.h"
 
 // External reference to generation parameters
 extern MapParameters current_params;
@@ -31,11 +33,36 @@ static const unsigned char PROGRESS_FULL = 0xA0;
 // Progress bar position and state
 static const unsigned char progress_x = 9;
 static const unsigned char progress_y = 12;
-static unsigned char progress_steps = 0;
+static unsigned char progress_steps = 0;        // Quarter cells drawn (0-80)
 
-// Phase boundary calculation (8 phases)
-static unsigned char phase_boundaries[8];
-static unsigned char phase_total_weight = 0;
+// Shared with the generator: phase, step and step count of the bar, and
+// the phase name to show (update_progress_step, show_phase)
+__zeropage unsigned char progress_bar_phase;
+__zeropage unsigned char progress_current;
+__zeropage unsigned char progress_total;
+__zeropage unsigned char progress_text_phase;
+static unsigned char progress_text_drawn = 255;
+
+// Raster IRQ that draws the progress once per frame, below the text area
+#define KERNAL_IRQ_VECTOR   (*(void **)0x0314)
+#define VIC_CTRL1           (*(volatile unsigned char *)0xD011)
+#define VIC_RASTER          (*(volatile unsigned char *)0xD012)
+#define VIC_IRQ_FLAGS       (*(volatile unsigned char *)0xD019)
+#define VIC_IRQ_ENABLE      (*(volatile unsigned char *)0xD01A)
+
+static const unsigned char PROGRESS_IRQ_LINE = 251;
+static void *progress_irq_saved;
+static unsigned char progress_irq_on = 0;
+
+static void progress_draw_phase(void);
+static void progress_irq_start(void);
+static void progress_irq_stop(void);
+
+// Phase boundary calculation (9 phases)
+static unsigned char phase_boundaries[9];
+static unsigned short phase_total_weight = 0;  // HUGE sums reach ~380
+
+unsigned char progress_muted = 0;
 
 // =============================================================================
 // CONSOLE OUTPUT
@@ -57,7 +84,9 @@ void print_text(const char* text) {
 // =============================================================================
 
 void init_progress_weights(void) {
-    unsigned char weights[8];
+    if (progress_muted) return;
+
+    unsigned char weights[9];
     weights[0] = current_params.max_rooms;
     weights[1] = current_params.max_rooms - 1;
     weights[2] = current_params.hidden_room_count;
@@ -65,32 +94,30 @@ void init_progress_weights(void) {
     weights[4] = current_params.deception_count;  // Decoys
     weights[5] = current_params.deception_count;  // Hidden passages (same count)
     weights[6] = 2;
-    weights[7] = 1;
+    weights[7] = current_params.max_rooms;        // Room population
+    weights[8] = 1;
 
     phase_total_weight = 0;
-    for (unsigned char i = 0; i < 8; i++) {
+    for (unsigned char i = 0; i < 9; i++) {
         phase_total_weight += weights[i];
     }
 
-    unsigned char accumulated = 0;
-    for (unsigned char i = 0; i < 8; i++) {
-        phase_boundaries[i] = ((unsigned short)accumulated * 80) / phase_total_weight;
+    unsigned short accumulated = 0;
+    for (unsigned char i = 0; i < 9; i++) {
+        phase_boundaries[i] = (accumulated * 80) / phase_total_weight;
         accumulated += weights[i];
     }
 }
 
-void init_progress_bar_simple(const char* title) {
-    progress_steps = 0;
-    clrscr();
-    gotoxy(13, 10);
-    print_text(title);
-}
-
-void update_progress_step(unsigned char phase, unsigned char current, unsigned char total) {
-    if (total == 0) return;
+// Bar position (0-80 quarter cells) for the shared progress state
+static unsigned char progress_position(void) {
+    unsigned char phase = progress_bar_phase;
+    unsigned char current = progress_current;
+    unsigned char total = progress_total;
+    if (phase > 8 || total == 0) return 0;
 
     unsigned char phase_start = phase_boundaries[phase];
-    unsigned char phase_end = (phase < 7) ? phase_boundaries[phase + 1] : 80;
+    unsigned char phase_end = (phase < 8) ? phase_boundaries[phase + 1] : 80;
     unsigned char phase_range = phase_end - phase_start;
 
     unsigned char phase_progress = 0;
@@ -100,35 +127,54 @@ void update_progress_step(unsigned char phase, unsigned char current, unsigned c
         phase_progress = ((unsigned short)current * phase_range) / total;
     }
 
-    progress_steps = phase_start + phase_progress;
-    if (progress_steps > 80) progress_steps = 80;
+    unsigned char steps = phase_start + phase_progress;
+    return steps > 80 ? 80 : steps;
+}
 
-    unsigned char pos = progress_steps >> 2;
-    unsigned char phase_char = progress_steps & 3;
+// Extend the bar to steps; it only grows, so a state read half-way
+// through an update never moves it back
+static void progress_draw_bar(unsigned char steps) {
+    if (steps <= progress_steps) return;
 
     volatile unsigned char * const screen_mem = (volatile unsigned char *)SCREEN_MEMORY_BASE;
     unsigned short base_pos = progress_y * 40 + (progress_x + 1);
+    unsigned char pos = steps >> 2;
 
-    for (unsigned char i = 0; i < pos && i < 20; i++) {
+    for (unsigned char i = progress_steps >> 2; i < pos && i < 20; i++) {
         screen_mem[base_pos + i] = PROGRESS_FULL;
     }
 
     if (pos < 20) {
+        unsigned char phase_char = steps & 3;
         unsigned char progress_char_val = PROGRESS_QUARTER;
         if (phase_char == 1) progress_char_val = PROGRESS_HALF;
         else if (phase_char == 2) progress_char_val = PROGRESS_THREE_Q;
         else if (phase_char == 3) progress_char_val = PROGRESS_FULL;
         screen_mem[base_pos + pos] = progress_char_val;
     }
+
+    progress_steps = steps;
+}
+
+void init_progress_bar_simple(const char* title) {
+    if (progress_muted) return;
+    progress_steps = 0;
+    progress_bar_phase = 0;
+    progress_current = 0;
+    progress_total = 0;
+    progress_text_phase = 255;
+    progress_text_drawn = 255;
+    clrscr();
+    gotoxy(13, 10);
+    print_text(title);
+    progress_irq_start();
 }
 
 void finish_progress_bar(void) {
-    progress_steps = 80;
-    volatile unsigned char * const screen_mem = (volatile unsigned char *)SCREEN_MEMORY_BASE;
-    unsigned short base_pos = progress_y * 40 + (progress_x + 1);
-    for (unsigned char i = 0; i < 20; i++) {
-        screen_mem[base_pos + i] = PROGRESS_FULL;
-    }
+    if (progress_muted) return;
+    progress_irq_stop();
+    progress_draw_phase();
+    progress_draw_bar(80);
 }
 
 // =============================================================================
@@ -143,28 +189,104 @@ static const char phase_strings[] =
     "Laying Traps\0"
     "Concealing Doors\0"
     "Placing Stairs\0"
+    "Populating Rooms\0"
     "Generation Complete!";
 
-static const unsigned char phase_offsets[8] = {0, 17, 35, 48, 63, 76, 93, 108};
+static const unsigned char phase_offsets[9] = {0, 17, 35, 48, 63, 76, 93, 108, 125};
 
-void show_phase(unsigned char phase_id) {
-    if (phase_id >= 8) return;
+// PETSCII (as printed by CHROUT) to screen code in the mixed charset
+static unsigned char petscii_to_screen(unsigned char c) {
+    if (c >= 0xC0) return c - 0x80;     // Shifted letters
+    if (c >= 0x40) return c - 0x40;     // Unshifted letters
+    return c;
+}
+
+// Phase name centered below the progress bar, if it changed
+static void progress_draw_phase(void) {
+    unsigned char phase_id = progress_text_phase;
+    if (phase_id == progress_text_drawn || phase_id >= 9) return;
 
     const char* text = phase_strings + phase_offsets[phase_id];
     unsigned char text_len = 0;
     const char* p = text;
     while (*p++) text_len++;
 
+    volatile unsigned char * const row = (volatile unsigned char *)SCREEN_MEMORY_BASE + (progress_y + 2) * 40;
     unsigned char phase_x = (40 - text_len) / 2;
 
-    gotoxy(0, progress_y + 2);
-    for (unsigned char i = 0; i < 40; i++) putchar(' ');
-    gotoxy(phase_x, progress_y + 2);
-    print_text(text);
+    for (unsigned char i = 0; i < 40; i++) row[i] = ' ';
+    for (unsigned char i = 0; i < text_len; i++) row[phase_x + i] = petscii_to_screen(text[i]);
+
+    progress_text_drawn = phase_id;
+}
+
+void show_phase(unsigned char phase_id) {
+    if (phase_id >= 9) return;
+    if (progress_muted) {
+        bench_phase_mark(phase_id);
+        return;
+    }
+
+    progress_text_phase = phase_id;
+    if (!progress_irq_on) progress_draw_phase();
 }
 
 void init_generation_progress(void) {
     init_progress_bar_simple("MAP GENERATION");
 }
 
+// =============================================================================
+// RASTER IRQ
+// =============================================================================
+
+// One frame of progress display, called from the raster IRQ
+__interrupt static void progress_irq_frame(void) {
+#ifdef MAPGEN_RASTER_TIMING
+    unsigned char border = RASTER_BORDER;
+    RASTER_MARK(RASTER_PROGRESS);
+#endif
+    progress_draw_phase();
+    progress_draw_bar(progress_position());
+#ifdef MAPGEN_RASTER_TIMING
+    RASTER_MARK(border);
+#endif
+}
+
+// Raster IRQ entry on the KERNAL IRQ vector (A/X/Y already pushed):
+// raster IRQs draw a frame and return, others go on to the saved handler
+// (KERNAL keyboard scan and jiffy clock)
+__asm progress_irq
+{
+    lda $d019
+    and #$01
+    beq other
+    sta $d019
+    jsr progress_irq_frame
+    jmp $ea81
+other:
+    jmp (progress_irq_saved)
+}
+
+static void progress_irq_start(void) {
+    __asm { sei }
+    progress_irq_saved = KERNAL_IRQ_VECTOR;
+    KERNAL_IRQ_VECTOR = progress_irq;
+    VIC_CTRL1 &= 0x7F;                  // Raster line bit 8
+    VIC_RASTER = PROGRESS_IRQ_LINE;
+    VIC_IRQ_FLAGS = 0x01;
+    VIC_IRQ_ENABLE = 0x01;
+    progress_irq_on = 1;
+    __asm { cli }
+}
+
+static void progress_irq_stop(void) {
+    if (!progress_irq_on) return;
+    __asm { sei }
+    VIC_IRQ_ENABLE = 0x00;
+    VIC_IRQ_FLAGS = 0x01;
+    KERNAL_IRQ_VECTOR = progress_irq_saved;
+    progress_irq_on = 0;
+    __asm { cli }
+}
+
 #endif // DEBUG_MAPGEN
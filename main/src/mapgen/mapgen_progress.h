@@ -2,7 +2,13 @@
 // Map Generator Progress Bar Module
 // =============================================================================
 // DEBUG-only progress bar and phase display system for map generation.
-// Provides visual feedback during the 8-phase generation pipeline.
+// Provides visual feedback during the 9-phase generation pipeline.
+//
+// The generator never draws: update_progress_step() and show_phase()
+// store a few zero page bytes, and a raster IRQ (installed by
+// init_progress_bar_simple(), removed by finish_progress_bar()) draws
+// the changes once per frame. Generation no longer waits for screen
+// output, and a tight loop of updates costs a few stores each.
 //
 // Only compiled when DEBUG_MAPGEN is defined.
 // =============================================================================
@@ -12,6 +18,17 @@
 
 #ifdef DEBUG_MAPGEN
 
+// Progress display off (benchmark runs): the progress functions return
+// at once and show_phase() only records phase times (bench_phase_mark)
+extern unsigned char progress_muted;
+
+// Progress shared between the generator and the raster IRQ that draws
+// it once per frame: the generator only stores these zero page bytes
+extern __zeropage unsigned char progress_bar_phase;     // Bar phase (0-8)
+extern __zeropage unsigned char progress_current;       // Step within the phase
+extern __zeropage unsigned char progress_total;         // Steps in the phase
+extern __zeropage unsigned char progress_text_phase;    // Phase name to show
+
 // =============================================================================
 // CONSOLE OUTPUT
 // =============================================================================
@@ -29,7 +46,7 @@ void print_text(const char* text);
 /**
  * @brief Initialize dynamic phase boundaries from current_params
  *
- * Calculates weighted boundaries for 8 generation phases based on
+ * Calculates weighted boundaries for 9 generation phases based on
  * actual room counts and feature percentages. Must be called after
  * current_params is set but before generation starts.
  */
@@ -38,25 +55,36 @@ void init_progress_weights(void);
 /**
  * @brief Initialize progress bar display with title
  * @param title Text to display above progress bar (e.g., "MAP GENERATION")
+ *
+ * Installs the raster IRQ that draws the progress from here on.
  */
 void init_progress_bar_simple(const char* title);
 
 /**
  * @brief Update progress bar for current phase
- * @param phase Phase index (0-7)
+ * @param phase Phase index (0-8)
  * @param current Current step within phase
  * @param total Total steps in phase
+ *
+ * Only stores the shared progress bytes; the raster IRQ draws the bar.
  */
-void update_progress_step(unsigned char phase, unsigned char current, unsigned char total);
+static inline void update_progress_step(unsigned char phase, unsigned char current, unsigned char total) {
+    if (total == 0) return;
+    progress_bar_phase = phase;
+    progress_current = current;
+    progress_total = total;
+}
 
 /**
  * @brief Fill progress bar to 100% complete
+ *
+ * Removes the raster IRQ; later show_phase() calls draw directly.
  */
 void finish_progress_bar(void);
 
 /**
  * @brief Display phase name centered below progress bar
- * @param phase_id Phase index (0-7)
+ * @param phase_id Phase index (0-8)
  *
  * Phase names:
  * 0: "Carving Chambers"
@@ -66,7 +94,8 @@ void finish_progress_bar(void);
  * 4: "Laying Traps"
  * 5: "Concealing Doors"
  * 6: "Placing Stairs"
- * 7: "Generation Complete!"
+ * 7: "Populating Rooms"
+ * 8: "Generation Complete!"
  */
 void show_phase(unsigned char phase_id);
 
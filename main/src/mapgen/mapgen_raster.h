@@ -0,0 +1,50 @@
+#ifndef MAPGEN_RASTER_H
+#define MAPGEN_RASTER_H
+
+// =============================================================================
+// RASTER TIMING - Border Colour per Generation Phase and Renderer Stage
+// =============================================================================
+//
+// Build with -dMAPGEN_RASTER_TIMING and the border ($D020) changes colour
+// when generate_level() enters a phase and when the map renderer enters
+// a stage, and goes back to RASTER_IDLE when they return. The height of
+// each colour band is the time spent there: one raster line is 63 cycles,
+// a full frame 312 lines (PAL).
+//
+// Renderer stages:
+// - REDRAW: full viewport decode and store (update_full_screen)
+// - SHIFT:  screen and buffer copy of a one-tile scroll
+// - FILL:   tile decode (get_map_tile) and store of the new row or column
+//
+// Works in every build; the DEBUG build has a legend overlay ('C' key,
+// show_raster_legend in mapgen_bench.h). Without the flag RASTER_MARK()
+// compiles to nothing.
+//
+// =============================================================================
+
+#define RASTER_BORDER   (*(volatile unsigned char *)0xD020)
+
+// Border colours (C64 palette)
+enum RasterTimingColours {
+    RASTER_IDLE = 0,                    // Black: outside measured code
+    RASTER_ROOMS = 2,                   // Red: create_rooms
+    RASTER_CORRIDORS = 5,               // Green: build_room_network
+    RASTER_HIDDEN = 6,                  // Blue: place_hidden_rooms
+    RASTER_NICHES = 4,                  // Purple: place_niches
+    RASTER_DECOYS = 8,                  // Orange: place_decoy_corridors
+    RASTER_PASSAGES = 9,                // Brown: place_hidden_passages
+    RASTER_STAIRS = 3,                  // Cyan: add_stairs
+    RASTER_POPULATE = 7,                // Yellow: populate_rooms
+    RASTER_REDRAW = 1,                  // White: full viewport redraw
+    RASTER_SHIFT = 12,                  // Grey: scroll copy
+    RASTER_FILL = 13,                   // Light green: new row/column
+    RASTER_PROGRESS = 10                // Light red: progress IRQ (DEBUG)
+};
+
+#ifdef MAPGEN_RASTER_TIMING
+#define RASTER_MARK(colour) (RASTER_BORDER = (colour))
+#else
+#define RASTER_MARK(colour) ((void)0)
+#endif
+
+#endif // MAPGEN_RASTER_H
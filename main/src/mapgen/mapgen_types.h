@@ -5,17 +5,36 @@
 enum MapConstants {
     MIN_MAP_SIZE = 48,
     MED_MAP_SIZE = 64,
+#ifdef MAPGEN_LARGE_MAPS
+    MAX_MAP_SIZE = 128,
+#else
     MAX_MAP_SIZE = 80,
+#endif
     VIEW_W = 40,
     VIEW_H = 25,
-    MAX_ROOMS = 20,  // Maximum for stable operation (16 grid positions + buffer)
-    MAX_CONNECTIONS = 20,  // Maximum corridor connections (MST + extras)
+#ifdef MAPGEN_LARGE_MAPS
+    MAX_ROOMS = 64,  // 8×8 grid of the HUGE preset
+    MAX_CONNECTIONS = 64,
+    MAX_GRID_SIZE = 8,
+#else
+    MAX_ROOMS = 25,  // Full 5×5 grid of the LARGE preset (32+ rooms: MAPGEN_LARGE_MAPS)
+    MAX_CONNECTIONS = 25,  // Maximum corridor connections (MST + extras)
+    MAX_GRID_SIZE = 5,
+#endif
     MIN_SIZE = 4,
     MAX_SIZE = 8,
     MIN_ROOM_DISTANCE = 4,
-    // GRID_SIZE removed - now dynamic based on map size (3×3, 4×4, or 5×5)
+    // GRID_SIZE removed - now dynamic based on map size (3×3, 4×4, 5×5 or 8×8)
+#ifdef MAPGEN_LARGE_MAPS
+    // Chunked map storage (see mapgen_utils.h): whole rows per chunk
+    MAP_CHUNK_SIZE = 0x600,         // 1536 bytes - 32 rows of a 128 wide map
+    MAP_LOW_CHUNKS = 2,             // In main RAM (compact_map)
+    MAP_CHUNKS = 4,                 // + 2 at MAP_HIGH_BASE
+    COMPACT_MAP_SIZE = MAP_CHUNK_SIZE * MAP_LOW_CHUNKS,
+#else
     // Max: (80*80*3+7)/8 = 2400 bytes
     COMPACT_MAP_SIZE = 2400,  // Max: (80*80*3+7)/8
+#endif
     COMPACT_MAP_CHUNKS = 10   // 2400/256
 };
 
@@ -63,6 +82,7 @@ const unsigned char CHECK_FLOORS_AND_DOORS = 3;
 #define ROOM_HIDDEN 0x01
 #define ROOM_HAS_NICHE 0x02
 #define ROOM_HAS_DECOY 0x04
+#define ROOM_DARK 0x08          // Set by populate_rooms(), chance rises with depth
 
 // Hidden room system constants
 const unsigned char HIDDEN_ROOM_PERCENTAGE = 50;  // Percentage of single-connection rooms to hide
@@ -78,18 +98,36 @@ typedef struct {
     unsigned char reserved : 5;            // 5 bits reserved for future use
 } Door; // 3 bytes total
 
+#ifdef MAPGEN_LARGE_MAPS
+// Connection structure with a full byte room ID (2 bytes, MAX_ROOMS > 32)
+typedef struct {
+    unsigned char room_id;                  // 0-255 room ID
+    unsigned char corridor_type : 2;        // 0-3 corridor types (Straight=0, L-shaped=1, Z-shaped=2)
+    unsigned char is_non_branching : 1;     // 1 bit - non-branching corridor flag (runtime tracking)
+} PackedConnection; // 2 bytes total
+#define CONN_ROOM_NONE 255                  // Unused slot marker
+#else
 // Packed connection structure (1 byte vs 2 bytes)
 typedef struct {
-    unsigned char room_id : 5;              // 0-31 room ID (5 bits, enough for MAX_ROOMS=20)
+    unsigned char room_id : 5;              // 0-31 room ID (5 bits, enough for MAX_ROOMS=25)
     unsigned char corridor_type : 2;        // 0-3 corridor types (2 bits: Straight=0, L-shaped=1, Z-shaped=2)
     unsigned char is_non_branching : 1;     // 1 bit - non-branching corridor flag (runtime tracking)
 } PackedConnection; // 1 byte total - optimized bitfield (corridor_type reduced 3→2 bits)
+#define CONN_ROOM_NONE 31                   // Unused slot marker
+#endif
 
 // Corridor breakpoint structure (2 bytes per breakpoint)
 typedef struct {
     unsigned char x, y;                    // 2 bytes - breakpoint coordinates
 } CorridorBreakpoint; // 2 bytes total - compact coordinate storage
 
+// Corridor bend points between two doors (5 bytes)
+typedef struct {
+    unsigned char count;                   // 0=straight, 1=L-shaped, 2=Z-shaped
+    unsigned char x[2];
+    unsigned char y[2];
+} CorridorBreakpoints;
+
 // Room structure (32 bytes total, optimized layout with wall counters)
 typedef struct {
     // Most frequently accessed during generation (ordered by access frequency)
@@ -122,4 +160,32 @@ typedef struct {
     unsigned char x, y;
 } Viewport;
 
+// Generation statistics: retries and rejections of the last generation,
+// per phase (mapgen_get_stats, 17 bytes)
+typedef struct {
+    // Rooms
+    unsigned int place_attempts;        // can_place_room() calls for grid cells
+    unsigned char cells_exhausted;      // Cells left empty after all attempts
+    unsigned char pin_fallbacks;        // Pinned room shrunk or not placed
+    // Room network (MST)
+    unsigned char mst_fallbacks;        // All-pairs steps (grid cut in two)
+    unsigned char connect_failures;     // connect_rooms() failures, candidate dropped
+    unsigned char rooms_unjoined;       // Rooms the MST gave up on
+    // Hidden rooms
+    unsigned char hidden_rejects;       // Chosen rooms with a branching or shared-wall door
+    // Niches
+    unsigned char niche_attempts;       // Rooms tried
+    unsigned char niche_rejects;        // Rooms without a usable wall
+    // Decoys
+    unsigned char decoy_attempts;       // Room walls tried
+    unsigned char decoy_fallbacks;      // Shaped/long decoys retried as the minimum straight
+    unsigned char decoy_path_rejects;   // Paths through rooms or corridors
+    unsigned char decoy_adjacent_rejects; // Dead ends next to floor or doors
+    // Hidden passages
+    unsigned char passage_candidates;   // Non-branching corridors found
+    unsigned char passage_rejects;      // Candidates no longer eligible when picked
+    // Region map
+    unsigned char span_overflows;       // Spans dropped with the pool full (tiles read REGION_NONE)
+} MapgenStats;
+
 #endif // MAPGEN_TYPES_H
\ No newline at end of file
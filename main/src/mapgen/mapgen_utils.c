@@ -9,6 +9,9 @@
 #include "mapgen_config.h"
 #include "mapgen_display.h"  // For reset_viewport_state, reset_display_state (DEBUG only)
 #include "tmea_core.h"
+#include "region_map.h"
+#include "flow_field.h"
+#include "mapgen_overlay.h"
 
 extern MapParameters current_params;
 unsigned char compact_map[COMPACT_MAP_SIZE];
@@ -26,12 +29,67 @@ static unsigned int rng_seed_16 = 1;
 
 unsigned short y_bit_stride = 0;
 
+#ifdef MAPGEN_LARGE_MAPS
+unsigned char *map_row_ptr[MAX_MAP_SIZE];
+
+// Padded row length of the chunked layout
+static unsigned char map_row_bytes(void) {
+    return ((unsigned short)current_params.map_width * 3 + 7) >> 3;
+}
+
+static unsigned char *map_chunk_base(unsigned char chunk) {
+    if (chunk < MAP_LOW_CHUNKS) return compact_map + chunk * MAP_CHUNK_SIZE;
+    return MAP_HIGH_BASE + (chunk - MAP_LOW_CHUNKS) * MAP_CHUNK_SIZE;
+}
+#endif
+
 void calculate_y_bit_stride(void) {
     y_bit_stride = (unsigned short)current_params.map_width * 3;
+
+#ifdef MAPGEN_LARGE_MAPS
+    unsigned char row_bytes = map_row_bytes();
+    unsigned char chunk_rows = MAP_CHUNK_SIZE / row_bytes;
+    unsigned char chunk = 0, row = 0;
+    unsigned char *p = compact_map;
+
+    for (unsigned char y = 0; y < current_params.map_height; y++) {
+        if (row == chunk_rows) {
+            p = map_chunk_base(++chunk);
+            row = 0;
+        }
+        map_row_ptr[y] = p;
+        p += row_bytes;
+        row++;
+    }
+#endif
+}
+
+unsigned char map_chunk_count(void) {
+#ifdef MAPGEN_LARGE_MAPS
+    unsigned char row_bytes = map_row_bytes();
+    if (!row_bytes) return 0;
+    unsigned char chunk_rows = MAP_CHUNK_SIZE / row_bytes;
+    return (current_params.map_height + chunk_rows - 1) / chunk_rows;
+#else
+    return 1;
+#endif
 }
 
-static inline unsigned short get_y_bit_offset_fast(unsigned char y) {
-    return (unsigned short)y * y_bit_stride;
+unsigned char *map_chunk_data(unsigned char chunk, unsigned int *size) {
+#ifdef MAPGEN_LARGE_MAPS
+    unsigned char row_bytes = map_row_bytes();
+    unsigned char chunk_rows = MAP_CHUNK_SIZE / row_bytes;
+    unsigned char rows = current_params.map_height - chunk * chunk_rows;
+    if (rows > chunk_rows) rows = chunk_rows;
+
+    *size = (unsigned int)rows * row_bytes;
+    return map_chunk_base(chunk);
+#else
+    unsigned short tile_bits = (unsigned short)current_params.map_width *
+                               current_params.map_height * 3;
+    *size = (tile_bits + 7) >> 3;
+    return compact_map;
+#endif
 }
 
 unsigned int get_random_seed(void) {
@@ -46,15 +104,20 @@ inline unsigned char rnd(unsigned char max) {
     return (unsigned char)(rnd_state_16 >> 8) % max;
 }
 
+inline unsigned char rnd_byte(void) {
+    rnd_state_16 = rnd_state_16 * 75 + 74;
+    return (unsigned char)(rnd_state_16 >> 8);
+}
+
 unsigned char get_compact_tile(unsigned char x, unsigned char y) {
     if (x >= current_params.map_width || y >= current_params.map_height) return TILE_EMPTY;
 
     // After bounds check, help compiler optimize bit arithmetic
-    __assume(x < 80);
-    __assume(y < 80);
+    __assume(x < MAX_MAP_SIZE);
+    __assume(y < MAX_MAP_SIZE);
 
-    unsigned short bit_offset = get_y_bit_offset_fast(y) + x + x + x;
-    unsigned char *byte_ptr = &compact_map[bit_offset >> 3];
+    unsigned short bit_offset = MAP_ROW_BITS(y) + x + x + x;
+    unsigned char *byte_ptr = &MAP_ROW_BASE(y)[bit_offset >> 3];
     unsigned char bit_pos = bit_offset & 7;
 
     if (bit_pos <= 5) {
@@ -71,12 +134,12 @@ void set_compact_tile(unsigned char x, unsigned char y, unsigned char tile) {
     if (x >= current_params.map_width || y >= current_params.map_height) return;
 
     // After bounds check, help compiler optimize bit arithmetic
-    __assume(x < 80);
-    __assume(y < 80);
+    __assume(x < MAX_MAP_SIZE);
+    __assume(y < MAX_MAP_SIZE);
     __assume(tile <= 7);
 
-    unsigned short bit_offset = get_y_bit_offset_fast(y) + x + x + x;
-    unsigned char *byte_ptr = &compact_map[bit_offset >> 3];
+    unsigned short bit_offset = MAP_ROW_BITS(y) + x + x + x;
+    unsigned char *byte_ptr = &MAP_ROW_BASE(y)[bit_offset >> 3];
     unsigned char bit_pos = bit_offset & 7;
     tile &= TILE_MASK;
 
@@ -94,19 +157,20 @@ void set_compact_tile(unsigned char x, unsigned char y, unsigned char tile) {
 }
 
 void clear_map(void) {
-    unsigned short tile_bits = (unsigned short)current_params.map_width *
-                               current_params.map_height * 3;
-    unsigned short total_bytes = (tile_bits + 7) >> 3;
+    unsigned char count = map_chunk_count();
 
-    unsigned char *ptr = compact_map;
-    unsigned char full_chunks = total_bytes >> 8;
-    unsigned char remainder = total_bytes & 0xFF;
+    for (unsigned char c = 0; c < count; c++) {
+        unsigned int total_bytes;
+        unsigned char *ptr = map_chunk_data(c, &total_bytes);
+        unsigned char full_chunks = total_bytes >> 8;
+        unsigned char remainder = total_bytes & 0xFF;
 
-    for (unsigned char chunk = 0; chunk < full_chunks; chunk++) {
-        for (unsigned char i = 0; i < 255; i++) *ptr++ = 0;
-        *ptr++ = 0;
+        for (unsigned char chunk = 0; chunk < full_chunks; chunk++) {
+            for (unsigned char i = 0; i < 255; i++) *ptr++ = 0;
+            *ptr++ = 0;
+        }
+        for (unsigned char i = 0; i < remainder; i++) *ptr++ = 0;
     }
-    for (unsigned char i = 0; i < remainder; i++) *ptr++ = 0;
 }
 
 inline unsigned char coords_in_bounds(unsigned char x, unsigned char y) {
@@ -250,12 +314,18 @@ void reset_all_generation_data(void) {
 
     room_count = 0;
     reset_tmea_data();
+    region_init();
+    flow_invalidate();
 
     total_connections = 0;
     total_hidden_rooms = 0;
     total_niches = 0;
     total_decoys = 0;
     available_walls_count = 0;
+    memset(&mapgen_stats, 0, sizeof(mapgen_stats));
+    stairs_up_room = 255;
+    stairs_down_room = 255;
+    stairs_path_length = STAIRS_NO_DISTANCE;
 }
 
 void mapgen_init(unsigned int seed) {
@@ -267,7 +337,11 @@ void mapgen_init(unsigned int seed) {
     clear_map();
 }
 
-unsigned char mapgen_generate_dungeon(void) {
+#ifdef MAPGEN_OVERLAY
+#pragma code(mgcode)
+#endif
+
+unsigned char MAPGEN_ENTRY(mapgen_generate_dungeon)(void) {
 #ifdef DEBUG_MAPGEN
     reset_viewport_state();
     reset_display_state();
@@ -276,7 +350,7 @@ unsigned char mapgen_generate_dungeon(void) {
     return generate_level();
 }
 
-unsigned char mapgen_generate_with_params(
+unsigned char MAPGEN_ENTRY(mapgen_generate_with_params)(
     unsigned char map_size,
     unsigned char hidden_rooms,
     unsigned char niches,
@@ -286,7 +360,7 @@ unsigned char mapgen_generate_with_params(
     MapParameters params;
 
     // Validate preset values (0-2)
-    if (map_size > 2 || hidden_rooms > 2 || niches > 2 || deception > 2) {
+    if (map_size > MAP_SIZE_MAX || hidden_rooms > 2 || niches > 2 || deception > 2) {
         return 1;
     }
 
@@ -308,6 +382,10 @@ unsigned char mapgen_generate_with_params(
     return result ? 0 : 2;
 }
 
+#ifdef MAPGEN_OVERLAY
+#pragma code(code)
+#endif
+
 /**
  * @brief Place walls around a room perimeter
  * @param x Room top-left X
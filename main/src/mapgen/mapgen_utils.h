@@ -5,13 +5,38 @@
 #include "mapgen_internal.h"  // For ExitPoint structure
 
 // Calculate and cache the Y bit stride for current map dimensions
+// (large-map builds: also the row table of the chunked layout)
 void calculate_y_bit_stride(void);
 // External reference to cached Y bit stride
 extern unsigned short y_bit_stride;
 
+// Map storage layout - tile (x, y) is at bit MAP_ROW_BITS(y) + 3x of MAP_ROW_BASE(y)
+#ifdef MAPGEN_LARGE_MAPS
+// Large maps (-dMAPGEN_LARGE_MAPS, up to 128×128): rows padded to whole
+// bytes and stored in MAP_CHUNK_SIZE chunks - MAP_LOW_CHUNKS in compact_map,
+// the rest in the free RAM at MAP_HIGH_BASE. A row never straddles two
+// chunks, and map_row_ptr[] caches the address of every row, so tile access
+// is one table read instead of the y * stride multiply.
+#ifndef MAP_HIGH_BASE
+#define MAP_HIGH_BASE       ((unsigned char *)0xC000)   // $C000-$CBFF
+#endif
+extern unsigned char *map_row_ptr[MAX_MAP_SIZE];        // 256 bytes
+#define MAP_ROW_BITS(y)     0
+#define MAP_ROW_BASE(y)     map_row_ptr[y]
+#else
+#define MAP_ROW_BITS(y)     ((unsigned short)(y) * y_bit_stride)
+#define MAP_ROW_BASE(y)     compact_map
+#endif
+
+// Map storage as blocks for snapshots and level packs (one block unless
+// MAPGEN_LARGE_MAPS); sizes follow current_params
+unsigned char map_chunk_count(void);
+unsigned char *map_chunk_data(unsigned char chunk, unsigned int *size);
+
 // RNG functions - 16-bit seed-based generation
 unsigned int get_random_seed(void);       // Generate random seed from hardware
 unsigned char rnd(unsigned char max);     // 16-bit LCG random number generator
+unsigned char rnd_byte(void);             // Full 0-255 LCG output (no modulo)
 
 // Seed-based generation API
 unsigned int mapgen_get_seed(void);       // Get current seed value
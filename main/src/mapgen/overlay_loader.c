@@ -0,0 +1,178 @@
+// =============================================================================
+// OVERLAY LOADER - Compressed Overlays Decoded While They Stream In
+// Implementation - Oscar64 Optimized
+// =============================================================================
+
+#include <c64/kernalio.h>
+#include <c64/memmap.h>
+#include "overlay_loader.h"
+#include "lz_codec.h"
+
+// =============================================================================
+// GLOBAL STATE DEFINITIONS
+// =============================================================================
+
+unsigned int overlay_park_size;                             // 2 bytes
+
+static char ovl_name[OVERLAY_NAME_MAX + 5];                 // 21 bytes - name + ",P,R"
+
+// Disk read buffer
+static unsigned char ovl_buf[OVERLAY_BUFFER];               // 64 bytes
+static unsigned char ovl_pos, ovl_len;
+static unsigned char ovl_error;
+
+// Memory configuration while decoding, and the one to return to
+static char ovl_bank, ovl_saved;
+
+// Header of the parked overlay
+static unsigned char *ovl_park_dst;
+static unsigned int ovl_park_unpacked;
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+// Banking needed to read back [start, end): ROMs above it switched out
+static char ovl_bank_for(unsigned int start, unsigned int end) {
+    if (end > 0xE000) return MMAP_NO_ROM;
+    if (end > 0xA000 && start < 0xC000) return MMAP_NO_BASIC;
+    return MMAP_ROM;
+}
+
+// MMAP_ROM as ovl_bank means: leave the banking alone
+static void ovl_bank_in(void) {
+    if (ovl_bank == MMAP_ROM) return;
+    if (ovl_bank == MMAP_NO_ROM) __asm { sei }
+    ovl_saved = mmap_set(ovl_bank);
+}
+
+static void ovl_bank_out(void) {
+    if (ovl_bank == MMAP_ROM) return;
+    mmap_set(ovl_saved);
+    if (ovl_bank == MMAP_NO_ROM) __asm { cli }
+}
+
+static unsigned char ovl_open(const char *filename) {
+    unsigned char n = 0;
+    while (*filename && n < OVERLAY_NAME_MAX) ovl_name[n++] = *filename++;
+    ovl_name[n++] = ',';
+    ovl_name[n++] = 'P';
+    ovl_name[n++] = ',';
+    ovl_name[n++] = 'R';
+    ovl_name[n] = 0;
+
+    ovl_pos = ovl_len = 0;
+    ovl_error = 0;
+    krnio_setnam(ovl_name);
+    return krnio_open(2, OVERLAY_DEVICE, 2);
+}
+
+// Next byte of the open file (0 and ovl_error set past the end).
+// Called from the decoder: the KERNAL is banked back in for the read.
+static unsigned char ovl_next(void) {
+    if (ovl_pos == ovl_len) {
+        ovl_bank_out();
+        int n = krnio_read(2, (char *)ovl_buf, OVERLAY_BUFFER);
+        ovl_bank_in();
+        if (n <= 0) {
+            ovl_error = 1;
+            return 0;
+        }
+        ovl_len = (unsigned char)n;
+        ovl_pos = 0;
+    }
+    return ovl_buf[ovl_pos++];
+}
+
+// Read and check the file header; returns 0 if not a packed overlay
+static unsigned char ovl_header(unsigned char **dst, unsigned int *size) {
+    unsigned char ok = ovl_next() == OVERLAY_MAGIC_0 &&
+                       ovl_next() == OVERLAY_MAGIC_1 &&
+                       ovl_next() == OVERLAY_VERSION;
+    unsigned int addr = ovl_next();
+    addr |= (unsigned int)ovl_next() << 8;
+    *size = ovl_next();
+    *size |= (unsigned int)ovl_next() << 8;
+    *dst = (unsigned char *)addr;
+
+    // Below the I/O area or under the KERNAL, not wrapping around
+    unsigned int end = addr + *size;
+    return ok && !ovl_error && *size && end > addr &&
+           (end <= 0xD000 || (addr >= 0xE000 && end <= 0xFFFA));
+}
+
+// =============================================================================
+// LOADER FUNCTIONS
+// =============================================================================
+
+unsigned char overlay_load(const char *filename) {
+    if (!ovl_open(filename)) return 0;
+
+    unsigned char *dst;
+    unsigned int size;
+    ovl_bank = MMAP_ROM;
+
+    unsigned char ok = ovl_header(&dst, &size);
+    if (ok) {
+        ovl_bank = ovl_bank_for((unsigned int)dst, (unsigned int)dst + size);
+        ovl_bank_in();
+        lz_decompress_stream(ovl_next, dst, size);
+        ovl_bank_out();
+
+        // Cut short: do not leave a valid header in front of partial code
+        if (ovl_error) dst[0] = 0;
+    }
+    krnio_close(2);
+
+    return ok && !ovl_error;
+}
+
+unsigned char overlay_park(const char *filename) {
+    overlay_park_size = 0;
+    if (!ovl_open(filename)) return 0;
+
+    ovl_bank = MMAP_ROM;
+
+    unsigned char ok = ovl_header(&ovl_park_dst, &ovl_park_unpacked);
+
+    // Unparking must not overwrite the parked copy
+    unsigned int start = (unsigned int)ovl_park_dst;
+    unsigned int end = start + ovl_park_unpacked;
+    if (end > (unsigned int)OVERLAY_PARK_BASE && start < (unsigned int)OVERLAY_PARK_BASE + OVERLAY_PARK_SIZE) ok = 0;
+
+    if (ok) {
+        // Rest of the disk buffer, then straight from the disk into the
+        // park RAM (writes go under the ROM, nothing is banked)
+        unsigned int n = ovl_len - ovl_pos;
+        for (unsigned char i = 0; i < n; i++) OVERLAY_PARK_BASE[i] = ovl_buf[ovl_pos + i];
+
+        int r;
+        while (n < OVERLAY_PARK_SIZE &&
+               (r = krnio_read(2, (char *)OVERLAY_PARK_BASE + n, OVERLAY_PARK_SIZE - n)) > 0) {
+            n += r;
+        }
+
+        // Fits only if the file ended inside the park area
+        if (n == OVERLAY_PARK_SIZE && krnio_read(2, (char *)ovl_buf, 1) > 0) ok = 0;
+        if (ok) overlay_park_size = n;
+    }
+    krnio_close(2);
+
+    return overlay_park_size != 0;
+}
+
+unsigned char overlay_unpark(void) {
+    if (!overlay_park_size) return 0;
+
+    // Both the park area and the destination must be readable
+    unsigned int start = (unsigned int)ovl_park_dst;
+    unsigned int end = start + ovl_park_unpacked;
+    if (start > (unsigned int)OVERLAY_PARK_BASE) start = (unsigned int)OVERLAY_PARK_BASE;
+    if (end < (unsigned int)OVERLAY_PARK_BASE + overlay_park_size) end = (unsigned int)OVERLAY_PARK_BASE + overlay_park_size;
+    ovl_bank = ovl_bank_for(start, end);
+
+    ovl_bank_in();
+    lz_decompress(OVERLAY_PARK_BASE, ovl_park_dst, ovl_park_unpacked);
+    ovl_bank_out();
+    return 1;
+}
@@ -0,0 +1,93 @@
+#ifndef OVERLAY_LOADER_H
+#define OVERLAY_LOADER_H
+
+// =============================================================================
+// OVERLAY LOADER - Compressed Overlays Decoded While They Stream In
+// =============================================================================
+//
+// KERNAL LOAD moves every byte of a module over the serial bus. Packed
+// overlays (tools/ovlpack) carry fewer bytes - lz_codec finds repeated
+// instruction sequences and zeroed tables - and the loader decodes them
+// straight from its 64 byte disk buffer to the load address: each refill
+// is followed by the decode of those bytes, so there is no staging copy
+// and no separate decompress pass after the load. Decode costs ~25
+// cycles per output byte against ~2500 per byte on the serial bus.
+//
+// File format (PRG file, read as a stream):
+// - 'O' 'Z' version
+// - load address (lo, hi), unpacked size (lo, hi)
+// - LZ stream (lz_codec format, one block)
+//
+// Load addresses under BASIC or KERNAL ROM are fine: writes always
+// reach the RAM, and the ROM is only banked out while decoding (LZ
+// matches read the output back). Under the KERNAL, IRQs are masked
+// during decode and the KERNAL is banked back in for each disk read.
+//
+// Parking: overlay_park() copies the packed file as is into the RAM
+// under the KERNAL with the ROMs and IRQs untouched - the intro music
+// keeps playing while the disk runs. overlay_unpark() later decodes it
+// from RAM (~0.2s for the generator) instead of going to the disk.
+//
+// Memory: 64 bytes disk buffer + ~12 bytes state
+//
+// =============================================================================
+
+#define OVERLAY_MAGIC_0     'O'
+#define OVERLAY_MAGIC_1     'Z'
+#define OVERLAY_VERSION     1
+
+enum OverlayLoaderConstants {
+    OVERLAY_HEADER_SIZE = 7,
+    OVERLAY_BUFFER = 64,                // Disk read buffer
+    OVERLAY_NAME_MAX = 16,              // Filename characters
+    OVERLAY_DEVICE = 8
+};
+
+// Park area: RAM under the KERNAL, or under BASIC when the level cache
+// has taken the KERNAL RAM (game_save staging then drops the park)
+#ifdef LEVEL_CACHE_UNDER_KERNAL
+#define OVERLAY_PARK_BASE   ((unsigned char *)0xA000)
+#define OVERLAY_PARK_SIZE   0x2000
+#else
+#define OVERLAY_PARK_BASE   ((unsigned char *)0xE000)
+#define OVERLAY_PARK_SIZE   0x1FFA      // Up to the CPU vectors
+#endif
+
+// =============================================================================
+// GLOBAL STATE DECLARATIONS
+// =============================================================================
+
+extern unsigned int overlay_park_size;  // Packed bytes parked (0 = none)
+
+// =============================================================================
+// LOADER FUNCTIONS
+// =============================================================================
+
+/**
+ * @brief Load a packed overlay, decoding while it is read
+ * @param filename PETSCII filename
+ * @return 1 on success, 0 on disk error or not a packed overlay
+ *
+ * A file that ends early clears the first byte at the load address, so
+ * a header the overlay starts with does not survive a partial decode.
+ */
+unsigned char overlay_load(const char *filename);
+
+/**
+ * @brief Read a packed overlay into the park area without decoding
+ * @param filename PETSCII filename
+ * @return 1 on success, 0 on disk error, not an overlay or too large
+ *
+ * Leaves ROM banking and IRQs alone, so IRQ-driven music keeps playing.
+ */
+unsigned char overlay_park(const char *filename);
+
+/**
+ * @brief Decode the parked overlay to its load address
+ * @return 1 on success, 0 if nothing is parked
+ *
+ * The parked copy stays, so the overlay can be unparked again.
+ */
+unsigned char overlay_unpark(void);
+
+#endif // OVERLAY_LOADER_H
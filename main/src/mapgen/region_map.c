@@ -0,0 +1,207 @@
+// =============================================================================
+// REGION MAP - Room/Corridor Membership Layer
+// Implementation - Oscar64 Optimized
+// =============================================================================
+
+#include "region_map.h"
+#include "mapgen_types.h"
+#include "mapgen_internal.h"
+#include "mapgen_utils.h"
+
+extern MapParameters current_params;
+
+// =============================================================================
+// GLOBAL STATE DEFINITIONS
+// =============================================================================
+
+RegionSpan region_spans[REGION_MAX_SPANS];          // 1270 bytes
+RegionSpanRef region_row_head[MAX_MAP_SIZE];        // 80 bytes
+RegionSpanRef region_col_head[MAX_MAP_SIZE];        // 80 bytes
+RegionSpanRef region_span_count;                    // 1 byte
+unsigned char region_corridor_count;                // 1 byte
+
+unsigned char region_corridor_room_a[REGION_MAX_CORRIDORS];    // 50 bytes
+unsigned char region_corridor_room_b[REGION_MAX_CORRIDORS];    // 50 bytes
+
+// Active corridor and end of its last segment (for shared-tile trimming)
+static unsigned char region_active = REGION_NONE;
+static unsigned char region_last_x, region_last_y;
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+/**
+ * @brief Insert span at head of a row or column list
+ * @param head Row or column list head
+ * @param pos Row y, or column x | REGION_SPAN_COLUMN
+ * @param lo, hi Inclusive range along the list direction
+ * @param id Region ID
+ *
+ * A touching or overlapping head span of the same region is extended instead.
+ */
+static void region_add_span(RegionSpanRef *head, unsigned char pos,
+                            unsigned char lo, unsigned char hi, unsigned char id) {
+    RegionSpanRef first = *head;
+
+    if (first != REGION_SPAN_END) {
+        RegionSpan *s = &region_spans[first];
+        if (s->id == id && s->hi + 1 >= lo && hi + 1 >= s->lo) {
+            if (lo < s->lo) s->lo = lo;
+            if (hi > s->hi) s->hi = hi;
+            return;
+        }
+    }
+
+    // Pool full - tiles stay REGION_NONE; counted so it shows up in the stats
+    if (region_span_count >= REGION_MAX_SPANS) {
+        mapgen_stats.span_overflows++;
+        return;
+    }
+
+    RegionSpan *s = &region_spans[region_span_count];
+    s->lo = lo;
+    s->hi = hi;
+    s->pos = pos;
+    s->id = id;
+    s->next = first;
+    *head = region_span_count;
+    region_span_count++;
+}
+
+// Find span containing coordinate in a list
+static unsigned char region_find(RegionSpanRef i, unsigned char c) {
+    while (i != REGION_SPAN_END) {
+        RegionSpan *s = &region_spans[i];
+        if (c >= s->lo && c <= s->hi) return s->id;
+        i = s->next;
+    }
+    return REGION_NONE;
+}
+
+// =============================================================================
+// RECORDING
+// =============================================================================
+
+void region_init(void) {
+    for (unsigned char i = 0; i < MAX_MAP_SIZE; i++) {
+        region_row_head[i] = REGION_SPAN_END;
+        region_col_head[i] = REGION_SPAN_END;
+    }
+    region_span_count = 0;
+    region_corridor_count = 0;
+    region_active = REGION_NONE;
+}
+
+void region_add_room(unsigned char room_id, unsigned char x, unsigned char y,
+                     unsigned char w, unsigned char h) {
+    unsigned char x1 = x + w - 1;
+    for (unsigned char iy = y; iy < y + h; iy++) {
+        region_add_span(&region_row_head[iy], iy, x, x1, room_id);
+    }
+}
+
+unsigned char region_begin_corridor(unsigned char room_a, unsigned char room_b) {
+    if (region_corridor_count >= REGION_MAX_CORRIDORS) {
+        region_active = REGION_NONE;
+        return REGION_NONE;
+    }
+
+    unsigned char n = region_corridor_count++;
+    region_corridor_room_a[n] = room_a;
+    region_corridor_room_b[n] = room_b;
+
+    region_active = REGION_CORRIDOR_BASE + n;
+    region_last_x = 255;
+    region_last_y = 255;
+    return region_active;
+}
+
+void region_add_segment(unsigned char x0, unsigned char y0,
+                        unsigned char x1, unsigned char y1) {
+    if (region_active == REGION_NONE) return;
+
+    unsigned char trim = (x0 == region_last_x && y0 == region_last_y);
+    region_last_x = x1;
+    region_last_y = y1;
+
+    unsigned char lo_x = (x0 < x1) ? x0 : x1;
+    unsigned char hi_x = (x0 < x1) ? x1 : x0;
+    unsigned char lo_y = (y0 < y1) ? y0 : y1;
+    unsigned char hi_y = (y0 < y1) ? y1 : y0;
+
+    if (y0 == y1) {
+        // Horizontal segment - one row span, drop shared start column
+        if (trim) {
+            if (x0 == x1) return;
+            if (x0 < x1) lo_x++; else hi_x--;
+        }
+        region_add_span(&region_row_head[y0], y0, lo_x, hi_x, region_active);
+        return;
+    }
+
+    // Vertical segment - drop shared start row
+    if (trim) {
+        if (y0 < y1) lo_y++; else hi_y--;
+    }
+
+    if (x0 == x1) {
+        region_add_span(&region_col_head[x0], x0 | REGION_SPAN_COLUMN, lo_y, hi_y, region_active);
+        return;
+    }
+
+    // Not axis-aligned (not produced by current corridor shapes) - bounding rows
+    for (unsigned char y = lo_y; y <= hi_y; y++) {
+        region_add_span(&region_row_head[y], y, lo_x, hi_x, region_active);
+    }
+}
+
+// =============================================================================
+// QUERIES
+// =============================================================================
+
+unsigned char region_at(unsigned char x, unsigned char y) {
+    if (x >= current_params.map_width || y >= current_params.map_height) return REGION_NONE;
+
+    unsigned char id = region_find(region_row_head[y], x);
+    if (id != REGION_NONE) return id;
+    return region_find(region_col_head[x], y);
+}
+
+// =============================================================================
+// ITERATORS
+// =============================================================================
+
+void region_iter_begin(RegionIter *it, unsigned char id) {
+    it->id = id;
+    it->span = REGION_SPAN_END;     // Advanced to first matching span by region_iter_next()
+    it->cur = 1;
+    it->hi = 0;
+}
+
+unsigned char region_iter_next(RegionIter *it, unsigned char *x, unsigned char *y) {
+    while (it->cur > it->hi) {
+        // Scan span pool for the next span of this region
+        do {
+            it->span++;
+            if (it->span >= region_span_count) {
+                it->span = region_span_count;
+                return 0;
+            }
+        } while (region_spans[it->span].id != it->id);
+
+        it->cur = region_spans[it->span].lo;
+        it->hi = region_spans[it->span].hi;
+    }
+
+    unsigned char pos = region_spans[it->span].pos;
+    if (pos & REGION_SPAN_COLUMN) {
+        *x = pos & ~REGION_SPAN_COLUMN;
+        *y = it->cur;
+    } else {
+        *x = it->cur;
+        *y = pos;
+    }
+    it->cur++;
+    return 1;
+}
@@ -10,6 +10,7 @@
 #include "mapgen_internal.h"   // For room placement/validation and global variable declarations
 #include "mapgen_utils.h"      // For utility functions
 #include "mapgen_progress.h"   // For progress bar functions (DEBUG only)
+#include "region_map.h"        // For region_add_room()
 
 // External reference to current generation parameters
 extern MapParameters current_params;
@@ -51,7 +52,8 @@ unsigned char can_place_room(unsigned char x, unsigned char y, unsigned char w,
     // Check if safety margin is clear
     for (unsigned char iy = buffer_y1; iy <= buffer_y2; iy++) {
         // Calculate Y bit offset once per row
-        unsigned short y_bit_offset = (unsigned short)iy * y_bit_stride;
+        unsigned short y_bit_offset = MAP_ROW_BITS(iy);
+        unsigned char *row = MAP_ROW_BASE(iy);
 
         for (unsigned char ix = buffer_x1; ix <= buffer_x2; ix++) {
             // Inline bit-packing logic for performance
@@ -65,7 +67,7 @@ unsigned char can_place_room(unsigned char x, unsigned char y, unsigned char w,
             unsigned short bit_offset = y_bit_offset + ix + ix + ix;
             
             // Get pointer to byte containing our tile data
-            unsigned char *byte_ptr = &compact_map[bit_offset >> 3];
+            unsigned char *byte_ptr = &row[bit_offset >> 3];
             unsigned char bit_pos = bit_offset & 7;
 
             // Extract 3-bit tile value from compact storage
@@ -150,6 +152,7 @@ unsigned char try_place_room_at_grid(unsigned char grid_index, unsigned char w,
         const unsigned char y = placement_min_y + rnd(range_y);
 
         // Test placement validity using optimized function
+        mapgen_stats.place_attempts++;
         if (can_place_room(x, y, w, h)) {
             *result_x = x;
             *result_y = y;
@@ -189,6 +192,7 @@ void place_room(unsigned char x, unsigned char y, unsigned char w, unsigned char
         room_list[room_count].decoy_end_x = 255;
         room_list[room_count].decoy_end_y = 255;
 
+        region_add_room(room_count, x, y, w, h);
         room_count++;
     }
 }
@@ -209,6 +213,11 @@ unsigned char room_has_connection_to(unsigned char room_idx, unsigned char targe
     return 0; // No connection found
 }
 
+// Resident in the overlay build: room_path uses it at game time
+#ifdef MAPGEN_OVERLAY
+#pragma code(code)
+#endif
+
 // Get connection info for specific connected room
 unsigned char get_connection_info(unsigned char room_idx, unsigned char target_room,
                                  unsigned char *door_x, unsigned char *door_y, 
@@ -227,6 +236,10 @@ unsigned char get_connection_info(unsigned char room_idx, unsigned char target_r
     return 0; // Connection not found
 }
 
+#ifdef MAPGEN_OVERLAY
+#pragma code(mgcode)
+#endif
+
 /**
  * @brief Update is_non_branching flag in connected room when corridor becomes branching
  * @param from_room Room index where branching was detected
@@ -336,8 +349,9 @@ void init_rooms(void) {
 
         // Initialize packed connection data
         for (unsigned char j = 0; j < 4; j++) {
-            room_list[i].conn_data[j].room_id = 31; // Invalid room index (unused slot marker)
+            room_list[i].conn_data[j].room_id = CONN_ROOM_NONE; // Invalid room index (unused slot marker)
             room_list[i].conn_data[j].corridor_type = 0;
+            room_list[i].conn_data[j].is_non_branching = 0;
 
             // Initialize doors
             room_list[i].doors[j].x = 0;
@@ -356,10 +370,50 @@ void init_rooms(void) {
     room_count = 0;
 }
 
+// Placement grid bookkeeping - the connection pipeline takes its
+// candidates from neighbouring cells instead of all room pairs
+unsigned char grid_room[MAX_GRID_SIZE * MAX_GRID_SIZE];    // 25 bytes
+unsigned char room_grid_cell[MAX_ROOMS];                    // 25 bytes
+
+// Room centred on the stairs pin, in the grid cell under the pin - the
+// first room placed, so only the map borders can reject it. A random size
+// that does not fit falls back to the smallest room.
+static unsigned char place_pinned_room(unsigned char grid_size) {
+    const unsigned char min_size = current_params.min_room_size;
+    const unsigned char size_range = current_params.max_room_size - min_size;
+    unsigned char w = min_size + rnd(size_range + 1);
+    unsigned char h = min_size + rnd(size_range + 1);
+    unsigned char x, y;
+
+    for (;;) {
+        // place_room() centres on x + (w - 1) / 2
+        if (stairs_pin_x >= MAP_BORDER + (w - 1) / 2 && stairs_pin_y >= MAP_BORDER + (h - 1) / 2) {
+            x = stairs_pin_x - (w - 1) / 2;
+            y = stairs_pin_y - (h - 1) / 2;
+            if (can_place_room(x, y, w, h)) break;
+        }
+        mapgen_stats.pin_fallbacks++;
+        if (w == min_size && h == min_size) return 0;
+        w = h = min_size;
+    }
+
+    unsigned char grid_x = (stairs_pin_x - MAP_BORDER) / get_grid_cell_width(current_params.map_width, grid_size);
+    unsigned char grid_y = (stairs_pin_y - MAP_BORDER) / get_grid_cell_height(current_params.map_height, grid_size);
+    if (grid_x >= grid_size) grid_x = grid_size - 1;
+    if (grid_y >= grid_size) grid_y = grid_size - 1;
+
+    const unsigned char cell = grid_y * grid_size + grid_x;
+    grid_room[cell] = room_count;
+    room_grid_cell[room_count] = cell;
+    stairs_pin_room = room_count;
+    place_room(x, y, w, h);
+    return 1;
+}
+
 // Generates all rooms using grid-based placement
 void create_rooms(void) {
     unsigned char placed_rooms = 0;
-    unsigned char grid_positions[25]; // Maximum 5x5 grid
+    unsigned char grid_positions[MAX_GRID_SIZE * MAX_GRID_SIZE]; // Maximum 5x5 grid (8x8 large maps)
     const unsigned char grid_size = current_params.grid_size;
     const unsigned char grid_total = grid_size * grid_size;
 
@@ -374,6 +428,7 @@ void create_rooms(void) {
     // Initialize grid position array
     for (unsigned char i = 0; i < grid_total; i++) {
         grid_positions[i] = i;
+        grid_room[i] = 255;
     }
 
     // Shuffle grid positions using Fisher-Yates algorithm
@@ -384,9 +439,16 @@ void create_rooms(void) {
         grid_positions[j] = temp;
     }
 
+    // Pinned up stairs (dungeon sets) take their cell first
+    stairs_pin_room = 255;
+    if (stairs_pin_x != 255 && place_pinned_room(grid_size)) {
+        placed_rooms++;
+    }
+
     // Generate rooms at shuffled grid positions
     for (unsigned char i = 0; i < grid_total && placed_rooms < current_params.max_rooms; i++) {
         unsigned char w, h, x, y;
+        if (grid_room[grid_positions[i]] != 255) continue; // Pinned room's cell
         unsigned char min_size = current_params.min_room_size;
         unsigned char max_size = current_params.max_room_size;
         unsigned char size_range = max_size - min_size;
@@ -397,12 +459,16 @@ void create_rooms(void) {
         
         // Attempt to place room at grid position
         if (try_place_room_at_grid(grid_positions[i], w, h, &x, &y)) {
+            grid_room[grid_positions[i]] = room_count;
+            room_grid_cell[room_count] = grid_positions[i];
             place_room(x, y, w, h);
             placed_rooms++;
 #ifdef DEBUG_MAPGEN
             // Phase 0: Room placement progress
             update_progress_step(0, placed_rooms, current_params.max_rooms);
 #endif
+        } else {
+            mapgen_stats.cells_exhausted++;
         }
     }
     
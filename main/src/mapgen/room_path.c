@@ -0,0 +1,274 @@
+// =============================================================================
+// ROOM PATH - Hierarchical Pathfinding over the Room Graph
+// Implementation - Oscar64 Optimized
+// =============================================================================
+
+#include "room_path.h"
+#include "region_map.h"
+#include "mapgen_types.h"
+#include "mapgen_internal.h"
+#include "mapgen_utils.h"
+#include "tmea_core.h"
+
+extern MapParameters current_params;
+
+// =============================================================================
+// GLOBAL STATE DEFINITIONS
+// =============================================================================
+
+unsigned char room_path[MAX_ROOMS];             // MAX_ROOMS bytes
+unsigned char room_path_len;                    // 1 byte
+unsigned int room_path_cost;                    // 2 bytes
+
+// Route corridors, one per room_path[] pair: polyline in travel order
+// (exit door, bends, entry door), built once by room_path_find
+typedef struct {
+    unsigned char x[4], y[4];
+    unsigned char last;                         // Entry door vertex (1-3)
+    unsigned char walls;                        // Exit wall side | entry wall side << 2
+} RoomPathLeg;                                  // 10 bytes
+
+static RoomPathLeg rp_legs[MAX_ROOMS - 1];      // 10 * (MAX_ROOMS - 1) bytes
+
+// Dijkstra search state
+static unsigned int rp_dist[MAX_ROOMS];         // 2 * MAX_ROOMS bytes
+static unsigned char rp_prev[MAX_ROOMS];        // MAX_ROOMS bytes
+static unsigned char rp_entry_x[MAX_ROOMS];     // MAX_ROOMS bytes - door the room is entered by
+static unsigned char rp_entry_y[MAX_ROOMS];     // MAX_ROOMS bytes
+static unsigned char rp_done[MAX_ROOMS];        // MAX_ROOMS bytes
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+// Tile just inside the room from a door on the given wall side
+static void rp_door_inward(unsigned char door_x, unsigned char door_y, unsigned char wall_side,
+                           unsigned char *x, unsigned char *y) {
+    *x = door_x;
+    *y = door_y;
+    switch (wall_side) {
+        case 0: (*x)++; break;  // Left wall
+        case 1: (*x)--; break;  // Right wall
+        case 2: (*y)++; break;  // Top wall
+        default: (*y)--; break; // Bottom wall
+    }
+}
+
+// One axis step towards target, X first
+static void rp_step_towards(unsigned char x, unsigned char y, unsigned char tx, unsigned char ty,
+                            unsigned char *nx, unsigned char *ny) {
+    *nx = x;
+    *ny = y;
+    if (x < tx) (*nx)++;
+    else if (x > tx) (*nx)--;
+    else if (y < ty) (*ny)++;
+    else if (y > ty) (*ny)--;
+}
+
+static unsigned char rp_on_segment(unsigned char x, unsigned char y,
+                                   unsigned char x0, unsigned char y0,
+                                   unsigned char x1, unsigned char y1) {
+    unsigned char lo_x = (x0 < x1) ? x0 : x1;
+    unsigned char hi_x = (x0 < x1) ? x1 : x0;
+    unsigned char lo_y = (y0 < y1) ? y0 : y1;
+    unsigned char hi_y = (y0 < y1) ? y1 : y0;
+    return x >= lo_x && x <= hi_x && y >= lo_y && y <= hi_y;
+}
+
+// Check if room_a's corridor to room_b was drawn from room_b's door
+static unsigned char rp_drawn_from_b(unsigned char room_a, unsigned char room_b) {
+    for (unsigned char c = 0; c < region_corridor_count; c++) {
+        if (region_corridor_room_a[c] == room_b && region_corridor_room_b[c] == room_a) return 1;
+        if (region_corridor_room_a[c] == room_a && region_corridor_room_b[c] == room_b) return 0;
+    }
+    return 0;
+}
+
+// Build the corridor polyline from room_a to room_b, in travel order
+static unsigned char rp_build_leg(unsigned char room_a, unsigned char room_b, RoomPathLeg *leg) {
+    unsigned char ax, ay, aw, bx, by, bw, type;
+    if (!get_connection_info(room_a, room_b, &ax, &ay, &aw, &type)) return 0;
+    if (!get_connection_info(room_b, room_a, &bx, &by, &bw, &type)) return 0;
+
+    // Bends in drawing order, which may run from room_b's door
+    unsigned char reverse = rp_drawn_from_b(room_a, room_b);
+    CorridorBreakpoints bp;
+    if (reverse) {
+        compute_corridor_breakpoints(bx, by, ax, ay, bw, type, &bp);
+    } else {
+        compute_corridor_breakpoints(ax, ay, bx, by, aw, type, &bp);
+    }
+
+    unsigned char last = bp.count + 1;
+    leg->x[0] = ax;    leg->y[0] = ay;
+    leg->x[last] = bx; leg->y[last] = by;
+    for (unsigned char i = 0; i < bp.count; i++) {
+        unsigned char v = reverse ? bp.count - i : i + 1;
+        leg->x[v] = bp.x[i];
+        leg->y[v] = bp.y[i];
+    }
+    leg->last = last;
+    leg->walls = aw | (bw << 2);
+    return 1;
+}
+
+/**
+ * @brief Step along a route corridor towards its entry door
+ * @return 1 if (x, y) lies on the corridor (step produced), 0 otherwise
+ */
+static unsigned char rp_leg_step(const RoomPathLeg *leg, unsigned char x, unsigned char y,
+                                 unsigned char *nx, unsigned char *ny) {
+    unsigned char last = leg->last;
+
+    // Arrived at the entry door - step into the room
+    if (x == leg->x[last] && y == leg->y[last]) {
+        rp_door_inward(x, y, leg->walls >> 2, nx, ny);
+        return 1;
+    }
+
+    // Head for the end of the segment we are on
+    for (unsigned char i = 0; i < last; i++) {
+        if ((x != leg->x[i + 1] || y != leg->y[i + 1]) &&
+            rp_on_segment(x, y, leg->x[i], leg->y[i], leg->x[i + 1], leg->y[i + 1])) {
+            rp_step_towards(x, y, leg->x[i + 1], leg->y[i + 1], nx, ny);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// =============================================================================
+// PLANNING
+// =============================================================================
+
+unsigned int room_path_edge_cost(unsigned char room, unsigned char slot,
+                                 unsigned char entry_x, unsigned char entry_y,
+                                 unsigned char known_only,
+                                 unsigned char *door_x, unsigned char *door_y) {
+    const Room *r = &room_list[room];
+    unsigned char dx = r->doors[slot].x;
+    unsigned char dy = r->doors[slot].y;
+    if (known_only && is_door_secret(dx, dy)) return ROOM_PATH_NO_COST;
+
+    unsigned char vx, vy, vw, type;
+    if (!get_connection_info(r->conn_data[slot].room_id, room, &vx, &vy, &vw, &type)) return ROOM_PATH_NO_COST;
+    if (known_only && is_door_secret(vx, vy)) return ROOM_PATH_NO_COST;
+
+    *door_x = vx;
+    *door_y = vy;
+    return manhattan_distance(entry_x, entry_y, dx, dy) + manhattan_distance(dx, dy, vx, vy);
+}
+
+unsigned char room_path_find(unsigned char from_room, unsigned char to_room) {
+    room_path_len = 0;
+    room_path_cost = ROOM_PATH_NO_COST;
+    if (from_room >= room_count || to_room >= room_count) return 0;
+
+    for (unsigned char i = 0; i < room_count; i++) {
+        rp_dist[i] = ROOM_PATH_NO_COST;
+        rp_done[i] = 0;
+    }
+    rp_dist[from_room] = 0;
+    rp_prev[from_room] = 255;
+    rp_entry_x[from_room] = room_list[from_room].center_x;
+    rp_entry_y[from_room] = room_list[from_room].center_y;
+
+    while (1) {
+        // Closest unfinished room (linear scan - at most MAX_ROOMS nodes)
+        unsigned char u = 255;
+        unsigned int best = ROOM_PATH_NO_COST;
+        for (unsigned char i = 0; i < room_count; i++) {
+            if (!rp_done[i] && rp_dist[i] < best) {
+                best = rp_dist[i];
+                u = i;
+            }
+        }
+        if (u == 255 || u == to_room) break;
+        rp_done[u] = 1;
+
+        Room *room = &room_list[u];
+        for (unsigned char c = 0; c < room->connections; c++) {
+            unsigned char v = room->conn_data[c].room_id;
+            if (v >= room_count || rp_done[v]) continue;
+
+            unsigned char vx, vy;
+            unsigned int edge = room_path_edge_cost(u, c, rp_entry_x[u], rp_entry_y[u], 1, &vx, &vy);
+            if (edge == ROOM_PATH_NO_COST) continue;
+
+            unsigned int cost = best + edge;
+            if (cost < rp_dist[v]) {
+                rp_dist[v] = cost;
+                rp_prev[v] = u;
+                rp_entry_x[v] = vx;
+                rp_entry_y[v] = vy;
+            }
+        }
+    }
+
+    if (rp_dist[to_room] == ROOM_PATH_NO_COST) return 0;
+
+    // Count path rooms, then fill room_path[] back to front
+    unsigned char n = 0;
+    for (unsigned char r = to_room; r != 255; r = rp_prev[r]) n++;
+
+    room_path_len = n;
+    room_path_cost = rp_dist[to_room];
+    for (unsigned char r = to_room; r != 255; r = rp_prev[r]) {
+        room_path[--n] = r;
+    }
+
+    // Corridor polylines for room_path_step, once per route
+    for (unsigned char k = 0; k + 1 < room_path_len; k++) {
+        if (!rp_build_leg(room_path[k], room_path[k + 1], &rp_legs[k])) rp_legs[k].last = 0;
+    }
+    return room_path_len;
+}
+
+// =============================================================================
+// REFINEMENT
+// =============================================================================
+
+unsigned char room_path_step(unsigned char x, unsigned char y,
+                             unsigned char *nx, unsigned char *ny) {
+    if (!room_path_len) return 0;
+
+    unsigned char rid = region_at(x, y);
+    unsigned char k = room_path_len;
+    if (region_is_room(rid)) {
+        k = 0;
+        while (k < room_path_len && room_path[k] != rid) k++;
+    }
+
+    // Route corridors leaving after this room (all of them off the route
+    // rooms) - a corridor tile, or a room floor a later route corridor
+    // crosses. Checked from the goal end: doors and branch tiles shared
+    // by two route corridors then resolve to the later one (no back-and-forth)
+    unsigned char first = k < room_path_len ? k + 1 : 0;
+    for (unsigned char j = room_path_len - 1; j > first; j--) {
+        const RoomPathLeg *leg = &rp_legs[j - 1];
+        if (leg->last && rp_leg_step(leg, x, y, nx, ny)) return 1;
+    }
+
+    if (k == room_path_len) {
+        // Off the route corridors: region_at() reports the corridor for
+        // a corridor carved across a room floor, so check the rooms
+        if (region_is_room(rid) || !point_in_any_room(x, y, &rid)) return 0;
+
+        k = 0;
+        while (k < room_path_len && room_path[k] != rid) k++;
+    }
+    if (k + 1 >= room_path_len) return 0;  // Goal room reached or off route
+
+    const RoomPathLeg *leg = &rp_legs[k];
+    if (!leg->last) return 0;
+
+    unsigned char dx = leg->x[0], dy = leg->y[0], ix, iy;
+    rp_door_inward(dx, dy, leg->walls & 3, &ix, &iy);
+    if (x == ix && y == iy) {
+        *nx = dx;
+        *ny = dy;
+    } else {
+        rp_step_towards(x, y, ix, iy, nx, ny);
+    }
+    return 1;
+}
@@ -0,0 +1,102 @@
+#ifndef ROOM_PATH_H
+#define ROOM_PATH_H
+
+// =============================================================================
+// ROOM PATH - Hierarchical Pathfinding over the Room Graph
+// =============================================================================
+//
+// Plans routes over rooms instead of tiles. Room.conn_data[] and Room.doors[]
+// already form the abstract graph: rooms are nodes, corridors are edges.
+//
+// Planning (room_path_find):
+// - Dijkstra over at most MAX_ROOMS nodes (weighted edges, so plain BFS
+//   would prefer fewer rooms over shorter walks)
+// - Edge cost: walk from the room entry point to the exit door, plus the
+//   door-to-door corridor length (manhattan - exact for the straight,
+//   L- and Z-shaped corridors the generator carves)
+// - Corridors with an undiscovered secret door at either end are skipped;
+//   they become passable once reveal_secret_door() sets the TMEA flag
+// - room_path_edge_cost is shared with the stair placement walk
+//
+// Refinement (room_path_step):
+// - Room or corridor: region_at() lookup, no scan over all rooms
+// - Inside a room: axis step towards the exit door (rooms are open floor)
+// - Inside a corridor: follow the corridor polyline; room_path_find builds
+//   the polylines of the route once (compute_corridor_breakpoints)
+// - A later route corridor carved across a room floor is followed through
+//   the room
+// - No tile search at all; cost is O(path rooms) per step
+// - Limitation: when an earlier route corridor crosses the floor of a
+//   later route room, the walker can bounce between the two (about 1 in
+//   50000 routes); callers should replan after a step limit
+//
+// Uses: monster patrols, ITEM_SCROLL_TELEPORT reachability checks,
+// auto-explore targets
+//
+// Performance: room_path_find ~25000 cycles (20 rooms) plus ~800 cycles
+// per route corridor, step ~600 cycles
+// Memory: MAX_ROOMS bytes path + 10 * (MAX_ROOMS - 1) bytes corridor
+// polylines + 6 * MAX_ROOMS bytes search state
+//
+// =============================================================================
+
+#include "mapgen_types.h"
+
+#define ROOM_PATH_NO_COST 0xFFFF
+
+// =============================================================================
+// GLOBAL STATE DECLARATIONS
+// =============================================================================
+
+extern unsigned char room_path[MAX_ROOMS];      // Room indices, start to goal
+extern unsigned char room_path_len;             // Rooms in path, 0 = no path
+extern unsigned int room_path_cost;             // Estimated walk length in tiles
+
+// =============================================================================
+// PLANNING
+// =============================================================================
+
+/**
+ * @brief Plan a room route between two rooms
+ * @param from_room Start room (walk measured from its center)
+ * @param to_room Goal room
+ * @return Number of rooms in room_path[], 0 if unreachable
+ *
+ * Only passes corridors whose doors are not hidden secret doors.
+ */
+unsigned char room_path_find(unsigned char from_room, unsigned char to_room);
+
+/**
+ * @brief Walk cost over one corridor of a room
+ * @param room Room walked through
+ * @param slot Connection slot of the corridor (conn_data[], doors[])
+ * @param entry_x Point the room is entered at (or its center)
+ * @param entry_y
+ * @param known_only 1 to refuse undiscovered secret doors at either end
+ * @param door_x Receives the door of the room at the far end
+ * @param door_y
+ * @return Entry point to exit door plus door-to-door length, or
+ *         ROOM_PATH_NO_COST if the corridor cannot be used
+ */
+unsigned int room_path_edge_cost(unsigned char room, unsigned char slot,
+                                 unsigned char entry_x, unsigned char entry_y,
+                                 unsigned char known_only,
+                                 unsigned char *door_x, unsigned char *door_y);
+
+// =============================================================================
+// REFINEMENT
+// =============================================================================
+
+/**
+ * @brief Get next tile along the planned route
+ * @param x Current X (in a room or corridor of the route)
+ * @param y Current Y
+ * @param nx Receives next X
+ * @param ny Receives next Y
+ * @return 1 if a step was produced, 0 if arrived in the goal room or
+ *         (x, y) is not on the route (caller replans)
+ */
+unsigned char room_path_step(unsigned char x, unsigned char y,
+                             unsigned char *nx, unsigned char *ny);
+
+#endif // ROOM_PATH_H
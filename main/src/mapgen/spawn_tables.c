@@ -0,0 +1,276 @@
+// =============================================================================
+// SPAWN TABLES - Alias-Method Weighted Loot and Monster Picks
+// Implementation - Oscar64 Optimized
+// =============================================================================
+
+#include <stddef.h>  // For NULL
+#include "spawn_tables.h"
+#include "tmea_core.h"
+#include "tmea_data.h"
+#include "tmea_types.h"
+#include "mapgen_types.h"
+#include "mapgen_internal.h"
+#include "mapgen_utils.h"
+
+// =============================================================================
+// GLOBAL STATE DEFINITIONS
+// =============================================================================
+
+static unsigned char spawn_loot_thr[SPAWN_MAX_LOOT];        // 64 bytes
+static unsigned char spawn_loot_alias[SPAWN_MAX_LOOT];      // 64 bytes
+static unsigned char spawn_loot_value[SPAWN_MAX_LOOT];      // 64 bytes
+
+static unsigned char spawn_mon_thr[SPAWN_MONSTER_TYPES];    // 8 bytes
+static unsigned char spawn_mon_alias[SPAWN_MONSTER_TYPES];  // 8 bytes
+static unsigned char spawn_mon_value[SPAWN_MONSTER_TYPES];  // 8 bytes
+
+SpawnTable spawn_loot = { 0, spawn_loot_thr, spawn_loot_alias, spawn_loot_value };
+SpawnTable spawn_monsters = { 0, spawn_mon_thr, spawn_mon_alias, spawn_mon_value };
+unsigned char spawn_depth = 255;                            // 255 = not built yet
+
+// Build scratch: weights, then weight * count during the alias split
+static unsigned int spawn_scaled[SPAWN_MAX_LOOT];           // 128 bytes
+static unsigned char spawn_work[SPAWN_MAX_LOOT];            // 64 bytes - small/large stacks
+
+// =============================================================================
+// CONSTANTS
+// =============================================================================
+
+#define SPAWN_GOLD_WEIGHT       16
+#define SPAWN_FOOD_WEIGHT       6
+#define SPAWN_TORCH_WEIGHT      4
+#define SPAWN_LOCKPICK_WEIGHT   2
+
+#define SPAWN_CURSED_THR        13      // 5% cursed equipment
+#define SPAWN_PLUS_1_THR        51      // 15% +1 equipment
+#define SPAWN_PLACE_TRIES       4       // Random tiles tried per entity
+
+// =============================================================================
+// LOOKUP TABLES (ROM)
+// =============================================================================
+
+// First depth each regular monster type appears on
+static const unsigned char spawn_mon_min_depth[SPAWN_MONSTER_TYPES] = {
+    0,  // RAT
+    0,  // GOBLIN
+    1,  // SKELETON
+    2,  // ORC
+    2,  // ZOMBIE
+    4,  // TROLL
+    3,  // GHOST
+    1   // SPIDER
+};
+
+// Spawn weight on that first depth (halves of it fade out with depth)
+static const unsigned char spawn_mon_base_weight[SPAWN_MONSTER_TYPES] = {
+    10, 10, 8, 7, 6, 4, 5, 8
+};
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+// Append an entry to the scratch weights
+static unsigned char spawn_add(unsigned char *values, unsigned char n,
+                               unsigned char value, unsigned char weight) {
+    if (weight && n < SPAWN_MAX_LOOT) {
+        values[n] = value;
+        spawn_scaled[n] = weight;
+        n++;
+    }
+    return n;
+}
+
+// Equipment, potions and scrolls unlock by price tier
+static unsigned char spawn_price_weight(unsigned char gold_price, unsigned char depth) {
+    unsigned char tier = gold_price >> 5;
+    return (tier <= depth) ? 4 + tier : 0;
+}
+
+// Vose's alias construction over spawn_scaled[0..n-1]
+static void spawn_build_alias(SpawnTable *table, unsigned char n) {
+    unsigned int total = 0;
+    unsigned char small = 0, large = n;
+
+    table->count = n;
+    if (!n) return;
+
+    for (unsigned char i = 0; i < n; i++) total += spawn_scaled[i];
+
+    // Columns below the average go to the small stack (front), the rest
+    // to the large stack (back); both share spawn_work[]
+    for (unsigned char i = 0; i < n; i++) {
+        spawn_scaled[i] *= n;
+        if (spawn_scaled[i] < total) spawn_work[small++] = i;
+        else spawn_work[--large] = i;
+    }
+
+    while (small && large < n) {
+        unsigned char s = spawn_work[--small];
+        unsigned char l = spawn_work[large++];
+
+        table->threshold[s] = (unsigned char)(((unsigned long)spawn_scaled[s] << 8) / total);
+        table->alias[s] = l;
+
+        // Large column donates the rest of the small column
+        spawn_scaled[l] -= total - spawn_scaled[s];
+        if (spawn_scaled[l] < total) spawn_work[small++] = l;
+        else spawn_work[--large] = l;
+    }
+
+    // Leftovers are full columns (rounding residue included)
+    while (small) {
+        unsigned char i = spawn_work[--small];
+        table->threshold[i] = 255;
+        table->alias[i] = i;
+    }
+    while (large < n) {
+        unsigned char i = spawn_work[large++];
+        table->threshold[i] = 255;
+        table->alias[i] = i;
+    }
+}
+
+static void spawn_build_loot(unsigned char depth) {
+    unsigned char *values = spawn_loot.value;
+    unsigned char n = 0;
+
+    for (unsigned char i = 0; i < 8; i++) {
+        n = spawn_add(values, n, ITEM_MAKE_TYPE(ITEM_CAT_WEAPON, i),
+                      spawn_price_weight(weapon_table[i].gold_price, depth));
+    }
+    for (unsigned char i = 0; i < 8; i++) {
+        n = spawn_add(values, n, ITEM_MAKE_TYPE(ITEM_CAT_ARMOR, i),
+                      spawn_price_weight(armor_table[i].gold_price, depth));
+    }
+    for (unsigned char i = 0; i < 5; i++) {
+        n = spawn_add(values, n, ITEM_MAKE_TYPE(ITEM_CAT_SHIELD, i),
+                      spawn_price_weight(shield_table[i].gold_price, depth));
+    }
+    for (unsigned char i = 0; i < 6; i++) {
+        n = spawn_add(values, n, ITEM_MAKE_TYPE(ITEM_CAT_POTION, i),
+                      spawn_price_weight(potion_table[i].gold_price, depth));
+    }
+    for (unsigned char i = 0; i < 14; i++) {
+        n = spawn_add(values, n, ITEM_MAKE_TYPE(ITEM_CAT_SCROLL, i),
+                      spawn_price_weight(scroll_table[i].gold_price, depth));
+    }
+    for (unsigned char i = 0; i < 5; i++) {
+        n = spawn_add(values, n, ITEM_MAKE_TYPE(ITEM_CAT_GEM, i), gem_table[i].rarity);
+    }
+    n = spawn_add(values, n, ITEM_GOLD, SPAWN_GOLD_WEIGHT);
+    n = spawn_add(values, n, ITEM_FOOD, SPAWN_FOOD_WEIGHT);
+    n = spawn_add(values, n, ITEM_TORCH, SPAWN_TORCH_WEIGHT);
+    n = spawn_add(values, n, ITEM_LOCKPICK, SPAWN_LOCKPICK_WEIGHT);
+
+    spawn_build_alias(&spawn_loot, n);
+}
+
+static void spawn_build_monsters(unsigned char depth) {
+    unsigned char *values = spawn_monsters.value;
+    unsigned char n = 0;
+
+    for (unsigned char t = 0; t < SPAWN_MONSTER_TYPES; t++) {
+        unsigned char min_depth = spawn_mon_min_depth[t];
+        if (depth < min_depth) continue;
+
+        // Early types thin out as the dungeon gets deeper
+        unsigned char fade = (depth - min_depth) >> 1;
+        unsigned char base = spawn_mon_base_weight[t];
+        n = spawn_add(values, n, t, (fade < base) ? base - fade : 1);
+    }
+
+    spawn_build_alias(&spawn_monsters, n);
+}
+
+// Data byte for a freshly rolled item
+static unsigned char spawn_roll_data(unsigned char type) {
+    unsigned char category = ITEM_GET_CATEGORY(type);
+    unsigned char depth = spawn_depth;
+
+    if (type == ITEM_GOLD) return 5 + rnd(10) + depth * 5;
+    if (type == ITEM_TORCH) return 128 + (rnd_byte() >> 1);
+
+    if (category == ITEM_CAT_WEAPON || category == ITEM_CAT_ARMOR ||
+        category == ITEM_CAT_SHIELD) {
+        unsigned char roll = rnd_byte();
+        if (roll < SPAWN_CURSED_THR) return ITEM_SET_MODIFIER(ITEM_MOD_CURSED);
+        if (roll < SPAWN_PLUS_1_THR) return ITEM_SET_MODIFIER(ITEM_MOD_PLUS_1);
+        if (roll > 255 - depth * 2) return ITEM_SET_MODIFIER(ITEM_MOD_PLUS_2);
+    }
+    return ITEM_MOD_NORMAL;
+}
+
+// Floor tile with nothing on it (stairs are not TILE_FLOOR)
+static unsigned char spawn_tile_free(unsigned char x, unsigned char y) {
+    return get_compact_tile(x, y) == TILE_FLOOR &&
+           get_objects_at(x, y) == NULL &&
+           get_monster_at(x, y) == NULL;
+}
+
+// =============================================================================
+// TABLE FUNCTIONS
+// =============================================================================
+
+void spawn_set_depth(unsigned char depth) {
+    if (depth > SPAWN_MAX_DEPTH) depth = SPAWN_MAX_DEPTH;
+    if (depth == spawn_depth) return;
+
+    spawn_depth = depth;
+    spawn_build_loot(depth);
+    spawn_build_monsters(depth);
+}
+
+unsigned char spawn_pick(const SpawnTable *table) {
+    if (!table->count) return 255;
+
+    unsigned char i = rnd(table->count);
+    return table->value[(rnd_byte() < table->threshold[i]) ? i : table->alias[i]];
+}
+
+// =============================================================================
+// SPAWN FUNCTIONS
+// =============================================================================
+
+TinyObj* spawn_random_object(unsigned char x, unsigned char y) {
+    if (spawn_depth == 255) spawn_set_depth(0);
+
+    unsigned char type = spawn_pick(&spawn_loot);
+    TinyObj *obj = spawn_object(x, y, type);
+    if (obj) obj->data = spawn_roll_data(type);
+    return obj;
+}
+
+TinyMon* spawn_random_monster(unsigned char x, unsigned char y) {
+    if (spawn_depth == 255) spawn_set_depth(0);
+
+    unsigned char type = spawn_pick(&spawn_monsters);
+    return spawn_monster(x, y, type, monster_table[type].base_hp);
+}
+
+unsigned char spawn_populate_room(unsigned char room_id, unsigned char objects,
+                                  unsigned char monsters) {
+    if (room_id >= room_count) return 0;
+
+    const Room *room = &room_list[room_id];
+    unsigned char total = objects + monsters;
+    unsigned char placed = 0;
+
+    // Objects first, then monsters, each on its own random free tile
+    for (unsigned char n = 0; n < total; n++) {
+        for (unsigned char tries = 0; tries < SPAWN_PLACE_TRIES; tries++) {
+            unsigned char x = room->x + rnd(room->w);
+            unsigned char y = room->y + rnd(room->h);
+            if (!spawn_tile_free(x, y)) continue;
+
+            // A full pool just drops the entity
+            if (n < objects) {
+                if (spawn_random_object(x, y)) placed++;
+            } else {
+                if (spawn_random_monster(x, y)) placed++;
+            }
+            break;
+        }
+    }
+    return placed;
+}
@@ -0,0 +1,105 @@
+#ifndef SPAWN_TABLES_H
+#define SPAWN_TABLES_H
+
+// =============================================================================
+// SPAWN TABLES - Alias-Method Weighted Loot and Monster Picks
+// =============================================================================
+//
+// Weighted random choice in O(1) with Walker's alias method:
+// - Column i = rnd(n), then rnd_byte() < threshold[i] ? entry i : alias[i]
+// - Thresholds are 8-bit (probability scaled to 0-256); full columns alias
+//   to themselves
+// - Built once per dungeon depth (spawn_set_depth), not per pick
+//
+// Weights per depth (derived from the ROM tables in tmea_data.c):
+// - Gems:           GemDef.rarity
+// - Equipment, potions, scrolls: price tier (gold_price / 32) must be
+//   <= depth; higher tiers weigh more once unlocked
+// - Gold, food, torches: fixed weights
+// - Monsters:       regular types unlock by depth, early types fade;
+//                   bosses are placed explicitly, never rolled
+//
+// Pick cost: ~150 cycles vs ~40 cycles per entry for a cumulative scan
+// Build cost: ~30000 cycles per depth change
+// Memory: 192 bytes loot table + 24 bytes monster table (RAM)
+//
+// =============================================================================
+
+#include "tmea_types.h"
+
+enum SpawnConstants {
+    SPAWN_MAX_LOOT = 64,                // Loot table entries
+    SPAWN_MONSTER_TYPES = 8,            // Regular monster types (MON_RAT..MON_SPIDER)
+    SPAWN_MAX_DEPTH = 15                // Deeper levels use depth 15 weights
+};
+
+// Alias table over byte values (item codes or monster types)
+typedef struct {
+    unsigned char count;                // Entries in use
+    unsigned char *threshold;           // Keep column if rnd_byte() < threshold
+    unsigned char *alias;               // Column to use otherwise
+    unsigned char *value;               // Item code / monster type per entry
+} SpawnTable;
+
+// =============================================================================
+// GLOBAL STATE DECLARATIONS
+// =============================================================================
+
+extern SpawnTable spawn_loot;           // Items for current depth
+extern SpawnTable spawn_monsters;       // Monsters for current depth
+extern unsigned char spawn_depth;       // Depth tables were built for
+
+// =============================================================================
+// TABLE FUNCTIONS
+// =============================================================================
+
+/**
+ * @brief Rebuild loot and monster tables for a dungeon depth
+ * @param depth Dungeon level (0 = first)
+ */
+void spawn_set_depth(unsigned char depth);
+
+/**
+ * @brief Pick an entry from an alias table
+ * @param table Built alias table
+ * @return Entry value, or 255 for an empty table
+ *
+ * Cost: one rnd() and one rnd_byte() call.
+ */
+unsigned char spawn_pick(const SpawnTable *table);
+
+// =============================================================================
+// SPAWN FUNCTIONS
+// =============================================================================
+
+/**
+ * @brief Spawn a weighted random item with rolled data byte
+ * @param x, y Position
+ * @return Spawned object, or NULL if the pool is full
+ *
+ * Data byte: gold amount, torch fuel or equipment modifier
+ * (occasionally +1/+2 or cursed).
+ */
+TinyObj* spawn_random_object(unsigned char x, unsigned char y);
+
+/**
+ * @brief Spawn a weighted random monster with full base HP
+ * @param x, y Position
+ * @return Spawned monster, or NULL if the pool is full
+ */
+TinyMon* spawn_random_monster(unsigned char x, unsigned char y);
+
+/**
+ * @brief Populate a room with random items and monsters in one pass
+ * @param room_id Room index
+ * @param objects Items to place
+ * @param monsters Monsters to place
+ * @return Number of entities placed
+ *
+ * Positions are random floor tiles inside the room; stairs and occupied
+ * tiles are skipped (a few retries per entity).
+ */
+unsigned char spawn_populate_room(unsigned char room_id, unsigned char objects,
+                                  unsigned char monsters);
+
+#endif // SPAWN_TABLES_H
@@ -0,0 +1,202 @@
+// =============================================================================
+// STATUS EFFECTS - Active-Mask Timer Engine
+// Implementation - Oscar64 Optimized
+// =============================================================================
+
+#include <stddef.h>  // For NULL
+#include "status_effects.h"
+#include "tmea_core.h"
+#include "tmea_types.h"
+
+// =============================================================================
+// GLOBAL STATE DEFINITIONS
+// =============================================================================
+
+unsigned int status_active;                                 // 2 bytes
+unsigned char status_mon_active;                            // 1 byte
+unsigned char status_mon_poison[MAX_TINY_MONSTERS];         // 6 bytes
+unsigned char status_mon_stun[MAX_TINY_MONSTERS];           // 6 bytes
+
+StatusHandler status_tick_handler = NULL;                   // 2 bytes
+StatusHandler status_expire_handler = NULL;                 // 2 bytes
+MonStatusHandler status_mon_handler = NULL;                 // 2 bytes
+
+// =============================================================================
+// LOOKUP TABLES (ROM)
+// =============================================================================
+
+// Index of lowest set bit in a nibble (entry 0 unused)
+static const unsigned char status_low_bit[16] = {
+    0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0
+};
+
+// STATUS_* bit -> byte offset in StatusTimers
+static const unsigned char status_timer_index[STATUS_BIT_COUNT] = {
+    0,                  // POISONED     -> poison_turns
+    1,                  // HASTE        -> haste_turns
+    2,                  // SHIELD_BUFF  -> shield_turns
+    3,                  // BERSERK      -> berserk_turns
+    4,                  // INVISIBLE    -> invis_turns
+    5,                  // BLESSED      -> blessed_turns
+    6,                  // CURSED       -> cursed_turns
+    STATUS_NO_TIMER,    // STUNNED      (one update)
+    STATUS_NO_TIMER,    // BLIND        (until cured)
+    7,                  // REGENERATING -> regen_turns
+    8,                  // FIRE_SHIELD  -> fire_shield_turns
+    9                   // CONFUSED     -> confused_turns
+};
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+// Lowest set bit of a non-zero byte
+static inline unsigned char status_lowest_bit(unsigned char bits) {
+    if (bits & 0x0F) return status_low_bit[bits & 0x0F];
+    return 4 + status_low_bit[bits >> 4];
+}
+
+// Bit index of a single STATUS_* flag
+static unsigned char status_bit_of(unsigned int flag) {
+    unsigned char lo = (unsigned char)flag;
+    if (lo) return status_lowest_bit(lo);
+    return 8 + status_lowest_bit((unsigned char)(flag >> 8));
+}
+
+static inline unsigned char *status_timer_ptr(unsigned char index) {
+    return (unsigned char *)&player_status_timers + index;
+}
+
+// One turn of one active player effect
+static void status_step(unsigned char bit) {
+    unsigned int flag = (unsigned int)1 << bit;
+    unsigned char index = status_timer_index[bit];
+
+    if (status_tick_handler) status_tick_handler(bit);
+
+    if (index == STATUS_NO_TIMER) {
+        if (flag != STATUS_STUNNED) return;     // Blind lasts until cured
+    } else {
+        unsigned char *timer = status_timer_ptr(index);
+        if (*timer > 1) {
+            (*timer)--;
+            return;
+        }
+        *timer = 0;
+    }
+
+    status_active &= ~flag;
+    if (status_expire_handler) status_expire_handler(bit);
+}
+
+static void status_scan(unsigned char bits, unsigned char base) {
+    while (bits) {
+        unsigned char bit = status_lowest_bit(bits);
+        bits &= bits - 1;
+        status_step(base + bit);
+    }
+}
+
+static void status_update_monsters(void) {
+    unsigned char bits = status_mon_active;
+
+    while (bits) {
+        unsigned char slot = status_lowest_bit(bits);
+        bits &= bits - 1;
+        TinyMon *mon = &mon_pool[slot];
+
+        if (status_mon_poison[slot] && (mon->flags & MFLAG_ALIVE)) {
+            if (status_mon_handler) status_mon_handler(mon, STATUS_MON_POISON_TICK);
+            if (--status_mon_poison[slot] == 0) {
+                mon->flags &= ~MFLAG_POISONED;
+                if (status_mon_handler) status_mon_handler(mon, STATUS_MON_POISON_END);
+            }
+        }
+        if (status_mon_stun[slot] && (mon->flags & MFLAG_ALIVE)) {
+            if (--status_mon_stun[slot] == 0) {
+                mon->flags &= ~MFLAG_STUNNED;
+                if (status_mon_handler) status_mon_handler(mon, STATUS_MON_STUN_END);
+            }
+        }
+
+        // Killed (possibly by the poison tick) or nothing left running
+        if (!(mon->flags & MFLAG_ALIVE)) {
+            status_mon_poison[slot] = 0;
+            status_mon_stun[slot] = 0;
+        }
+        if (!status_mon_poison[slot] && !status_mon_stun[slot]) {
+            status_mon_active &= ~(unsigned char)(1 << slot);
+        }
+    }
+}
+
+// =============================================================================
+// PLAYER FUNCTIONS
+// =============================================================================
+
+void status_init(void) {
+    status_active = STATUS_NONE;
+    status_mon_active = 0;
+    for (unsigned char i = 0; i < MAX_TINY_MONSTERS; i++) {
+        status_mon_poison[i] = 0;
+        status_mon_stun[i] = 0;
+    }
+}
+
+void status_apply(unsigned int flag, unsigned char turns) {
+    if (!flag) return;
+    unsigned char bit = status_bit_of(flag);
+    if (bit >= STATUS_BIT_COUNT) return;
+
+    unsigned char index = status_timer_index[bit];
+    if (index != STATUS_NO_TIMER) {
+        unsigned char *timer = status_timer_ptr(index);
+        if (turns == 0) turns = 1;
+        if (turns > *timer) *timer = turns;
+    }
+    status_active |= (unsigned int)1 << bit;
+}
+
+void status_clear(unsigned int flag) {
+    if (!flag) return;
+    unsigned char bit = status_bit_of(flag);
+    if (bit >= STATUS_BIT_COUNT) return;
+
+    unsigned char index = status_timer_index[bit];
+    if (index != STATUS_NO_TIMER) {
+        *status_timer_ptr(index) = 0;
+    }
+    status_active &= ~((unsigned int)1 << bit);
+}
+
+// =============================================================================
+// MONSTER FUNCTIONS
+// =============================================================================
+
+void status_apply_monster(TinyMon *mon, unsigned char mflag, unsigned char turns) {
+    unsigned char slot = (unsigned char)(mon - mon_pool);
+    unsigned char *timer;
+
+    if (mflag == MFLAG_POISONED) timer = &status_mon_poison[slot];
+    else if (mflag == MFLAG_STUNNED) timer = &status_mon_stun[slot];
+    else return;
+
+    if (turns == 0) turns = 1;
+    if (turns > *timer) *timer = turns;
+    mon->flags |= mflag;
+    status_mon_active |= (unsigned char)(1 << slot);
+}
+
+// =============================================================================
+// TURN UPDATE
+// =============================================================================
+
+void status_update(void) {
+    if (status_active) {
+        status_scan((unsigned char)status_active, 0);
+        status_scan((unsigned char)(status_active >> 8), 8);
+    }
+    if (status_mon_active) {
+        status_update_monsters();
+    }
+}
@@ -0,0 +1,118 @@
+#ifndef STATUS_EFFECTS_H
+#define STATUS_EFFECTS_H
+
+// =============================================================================
+// STATUS EFFECTS - Active-Mask Timer Engine
+// =============================================================================
+//
+// Per-turn countdown of player STATUS_* effects (StatusTimers) and monster
+// MFLAG_POISONED / MFLAG_STUNNED.
+//
+// Player:
+// - status_active mirrors the STATUS_* flags of effects currently running
+// - Only set bits are visited: lowest set bit found with a 16-entry
+//   nibble table, then cleared from a working copy
+// - Timed effects count down their StatusTimers byte; STATUS_STUNNED lasts
+//   one update, STATUS_BLIND stays until status_clear()
+//
+// Monsters:
+// - status_mon_active has one bit per mon_pool slot with poison or stun
+// - Turn counts in status_mon_poison[] / status_mon_stun[]
+//
+// Callbacks (optional, NULL = none):
+// - status_tick_handler:   every update for each active player effect
+// - status_expire_handler: when a player effect runs out
+// - status_mon_handler:    monster poison tick and poison/stun expiry
+//
+// Common case (nothing active): one 16-bit and one 8-bit zero test.
+//
+// Performance: ~20 cycles idle, ~120 cycles per active effect
+// Memory: 3 bytes masks + 12 bytes monster timers + 6 bytes handlers
+//
+// =============================================================================
+
+#include "tmea_types.h"
+
+enum StatusConstants {
+    STATUS_BIT_COUNT = 12,              // STATUS_POISONED .. STATUS_CONFUSED
+    STATUS_NO_TIMER = 255               // Bit has no StatusTimers byte
+};
+
+// Monster status event codes for status_mon_handler
+#define STATUS_MON_POISON_TICK  0       // Poison damage due this turn
+#define STATUS_MON_POISON_END   1       // MFLAG_POISONED cleared
+#define STATUS_MON_STUN_END     2       // MFLAG_STUNNED cleared
+
+// Callback types
+typedef void (*StatusHandler)(unsigned char status_bit);
+typedef void (*MonStatusHandler)(TinyMon *mon, unsigned char event);
+
+// =============================================================================
+// GLOBAL STATE DECLARATIONS
+// =============================================================================
+
+extern unsigned int status_active;                          // STATUS_* flags
+extern unsigned char status_mon_active;                     // Bit per mon_pool slot
+extern unsigned char status_mon_poison[MAX_TINY_MONSTERS];  // Poison turns left
+extern unsigned char status_mon_stun[MAX_TINY_MONSTERS];    // Stun turns left
+
+extern StatusHandler status_tick_handler;
+extern StatusHandler status_expire_handler;
+extern MonStatusHandler status_mon_handler;
+
+// =============================================================================
+// PLAYER FUNCTIONS
+// =============================================================================
+
+/**
+ * @brief Clear all player and monster effects (new level)
+ */
+void status_init(void);
+
+/**
+ * @brief Start or extend a player effect
+ * @param flag Single STATUS_* flag
+ * @param turns Duration (longer of current and new wins)
+ */
+void status_apply(unsigned int flag, unsigned char turns);
+
+/**
+ * @brief End a player effect without firing the expiry callback (cure)
+ * @param flag Single STATUS_* flag
+ */
+void status_clear(unsigned int flag);
+
+/**
+ * @brief Check if a player effect is active
+ * @param flag STATUS_* flag(s)
+ * @return Non-zero if any given flag is active
+ */
+static inline unsigned char status_has(unsigned int flag) {
+    return (status_active & flag) != 0;
+}
+
+// =============================================================================
+// MONSTER FUNCTIONS
+// =============================================================================
+
+/**
+ * @brief Poison or stun a monster
+ * @param mon Monster from mon_pool
+ * @param mflag MFLAG_POISONED or MFLAG_STUNNED
+ * @param turns Duration (longer of current and new wins)
+ */
+void status_apply_monster(TinyMon *mon, unsigned char mflag, unsigned char turns);
+
+// =============================================================================
+// TURN UPDATE
+// =============================================================================
+
+/**
+ * @brief Advance all active effects by one turn
+ *
+ * Fires tick callbacks, counts down timers, clears expired flags
+ * and fires expiry callbacks.
+ */
+void status_update(void);
+
+#endif // STATUS_EFFECTS_H
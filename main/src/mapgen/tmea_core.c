@@ -15,8 +15,8 @@
 // =============================================================================
 
 // Room-scoped metadata storage
-RoomTileMeta room_metas[MAX_ROOMS][META_PER_ROOM];  // 240 bytes
-unsigned char room_meta_count[MAX_ROOMS];           // 20 bytes
+RoomTileMeta room_metas[MAX_ROOMS][META_PER_ROOM];  // 300 bytes
+unsigned char room_meta_count[MAX_ROOMS];           // 25 bytes
 
 // Global metadata storage (corridors and map-wide)
 GlobalTileMeta global_metas[GLOBAL_META_POOL_SIZE]; // 64 bytes
@@ -130,8 +130,10 @@ void reset_tmea_data(void) {
     obj_active_list = NULL;
 
     // Reset monster pool (rebuild free list)
-    for (i = 0; i < MAX_TINY_MONSTERS - 1; i++) {
+    // Clear flags too: free slots must not look alive to code scanning mon_pool
+    for (i = 0; i < MAX_TINY_MONSTERS; i++) {
         mon_pool[i].next = &mon_pool[i + 1];
+        mon_pool[i].flags = 0;
     }
     mon_pool[MAX_TINY_MONSTERS - 1].next = NULL;
     mon_free_list = &mon_pool[0];
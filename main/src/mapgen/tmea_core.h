@@ -35,8 +35,8 @@
 // Room-scoped tile metadata storage
 // Array indexed by: [room_id][meta_slot_index]
 // Each room has META_PER_ROOM (4) metadata slots
-extern RoomTileMeta room_metas[MAX_ROOMS][META_PER_ROOM];  // 240 bytes
-extern unsigned char room_meta_count[MAX_ROOMS];           // 20 bytes
+extern RoomTileMeta room_metas[MAX_ROOMS][META_PER_ROOM];  // 300 bytes
+extern unsigned char room_meta_count[MAX_ROOMS];           // 25 bytes
 
 // Global tile metadata storage (for corridors and map-wide features)
 // Linear array with sequential allocation
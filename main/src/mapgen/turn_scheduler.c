@@ -0,0 +1,175 @@
+// =============================================================================
+// TURN SCHEDULER - Speed-Bucketed Energy Queue
+// Implementation - Oscar64 Optimized
+// =============================================================================
+
+#include "turn_scheduler.h"
+#include "tmea_core.h"
+#include "tmea_data.h"
+#include "tmea_types.h"
+
+// =============================================================================
+// GLOBAL STATE DEFINITIONS
+// =============================================================================
+
+unsigned char sched_tick;                                   // 1 byte
+unsigned char sched_player_delay = SCHED_DELAY_NORMAL;      // 1 byte
+
+static unsigned char sched_bucket_head[SCHED_BUCKETS];      // 32 bytes
+static unsigned char sched_link[SCHED_MAX_ACTORS];          // 7 bytes - next actor in bucket
+static unsigned char sched_bucket_of[SCHED_MAX_ACTORS];     // 7 bytes - bucket or SCHED_NONE
+
+// =============================================================================
+// LOOKUP TABLES (ROM)
+// =============================================================================
+
+// Action delay per monster type (SCHED_DELAY_NORMAL = 12)
+static const unsigned char sched_monster_delay[MON_TYPE_COUNT] = {
+     8,     // RAT - fast
+    12,     // GOBLIN
+    12,     // SKELETON
+    12,     // ORC
+    18,     // ZOMBIE - slow
+    14,     // TROLL
+    10,     // GHOST
+     9,     // SPIDER
+    10,     // BOSS_DEMON
+    12,     // BOSS_LICH
+    14      // BOSS_DRAGON
+};
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+// Append actor to the bucket of tick sched_tick + delay (FIFO for equal ticks)
+static void sched_insert(unsigned char actor, unsigned char delay) {
+    if (delay == 0) delay = 1;
+    if (delay > SCHED_MAX_DELAY) delay = SCHED_MAX_DELAY;
+
+    unsigned char b = (sched_tick + delay) & (SCHED_BUCKETS - 1);
+    sched_link[actor] = SCHED_NONE;
+    sched_bucket_of[actor] = b;
+
+    unsigned char i = sched_bucket_head[b];
+    if (i == SCHED_NONE) {
+        sched_bucket_head[b] = actor;
+        return;
+    }
+    while (sched_link[i] != SCHED_NONE) i = sched_link[i];
+    sched_link[i] = actor;
+}
+
+static void sched_remove(unsigned char actor) {
+    unsigned char b = sched_bucket_of[actor];
+    if (b == SCHED_NONE) return;
+    sched_bucket_of[actor] = SCHED_NONE;
+
+    unsigned char i = sched_bucket_head[b];
+    if (i == actor) {
+        sched_bucket_head[b] = sched_link[actor];
+        return;
+    }
+    while (i != SCHED_NONE && sched_link[i] != actor) i = sched_link[i];
+    if (i != SCHED_NONE) sched_link[i] = sched_link[actor];
+}
+
+static inline unsigned char sched_monster_awake(const TinyMon *mon) {
+    return (mon->flags & MFLAG_ALIVE) &&
+           mon->state != MSTATE_SLEEP && mon->state != MSTATE_IDLE;
+}
+
+// =============================================================================
+// QUEUE FUNCTIONS
+// =============================================================================
+
+void sched_init(void) {
+    for (unsigned char i = 0; i < SCHED_BUCKETS; i++) {
+        sched_bucket_head[i] = SCHED_NONE;
+    }
+    for (unsigned char i = 0; i < SCHED_MAX_ACTORS; i++) {
+        sched_bucket_of[i] = SCHED_NONE;
+    }
+    sched_tick = 0;
+    sched_insert(SCHED_PLAYER, sched_player_delay);
+}
+
+unsigned char sched_next(void) {
+    // Ticks advanced this call - every ready actor is due within one ring,
+    // so a full ring means the queue is empty or holds only stunned monsters
+    unsigned char n = 0;
+    while (1) {
+        // Advance to the first non-empty bucket
+        unsigned char b = sched_tick & (SCHED_BUCKETS - 1);
+        while (sched_bucket_head[b] == SCHED_NONE) {
+            if (++n >= SCHED_BUCKETS) return SCHED_NONE;   // Nobody ready
+            sched_tick++;
+            b = sched_tick & (SCHED_BUCKETS - 1);
+        }
+
+        unsigned char actor = sched_bucket_head[b];
+        sched_bucket_head[b] = sched_link[actor];
+        sched_bucket_of[actor] = SCHED_NONE;
+
+        if (actor == SCHED_PLAYER) return actor;
+
+        TinyMon *mon = &mon_pool[actor - 1];
+        if (!sched_monster_awake(mon)) continue;          // Died or fell asleep - drop
+
+        if ((mon->flags & MFLAG_STUNNED) || mon->state == MSTATE_STUNNED) {
+            sched_insert(actor, sched_monster_delay[mon->type]);
+            continue;
+        }
+        return actor;
+    }
+}
+
+void sched_done(unsigned char actor, unsigned char delay) {
+    if (actor >= SCHED_MAX_ACTORS || sched_bucket_of[actor] != SCHED_NONE) return;
+    sched_insert(actor, delay);
+}
+
+void sched_update_monster(TinyMon *mon) {
+    unsigned char actor = (unsigned char)(mon - mon_pool) + 1;
+
+    if (sched_monster_awake(mon)) {
+        if (sched_bucket_of[actor] == SCHED_NONE) {
+            sched_insert(actor, sched_monster_delay[mon->type]);
+        }
+    } else {
+        sched_remove(actor);
+    }
+}
+
+// =============================================================================
+// SPEED FUNCTIONS
+// =============================================================================
+
+unsigned char sched_compute_player_delay(unsigned char weapon_subtype,
+                                         unsigned char armor_subtype,
+                                         unsigned char hasted) {
+    unsigned char delay = SCHED_DELAY_NORMAL;
+
+    // Weapon speed 1-15, 10 = normal; each 2 points faster saves a tick
+    const WeaponDef *weapon = get_weapon_def(weapon_subtype);
+    if (weapon) {
+        delay = delay + 5 - (weapon->speed >> 1);
+    }
+
+    // Armour weight class 0-3 adds ticks
+    const ArmorDef *armor = get_armor_def(armor_subtype);
+    if (armor) {
+        delay += armor->weight;
+    }
+
+    // Haste: +50% speed = 2/3 delay
+    if (hasted) {
+        delay -= delay / 3;
+    }
+    return delay;
+}
+
+unsigned char sched_actor_delay(unsigned char actor) {
+    if (actor == SCHED_PLAYER) return sched_player_delay;
+    return sched_monster_delay[mon_pool[actor - 1].type];
+}
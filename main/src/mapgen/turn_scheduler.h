@@ -0,0 +1,117 @@
+#ifndef TURN_SCHEDULER_H
+#define TURN_SCHEDULER_H
+
+// =============================================================================
+// TURN SCHEDULER - Speed-Bucketed Energy Queue
+// =============================================================================
+//
+// Decides who acts next when actors have different speeds.
+//
+// Actors:
+// - 0:                         player
+// - 1 .. MAX_TINY_MONSTERS:    mon_pool[actor - 1]
+//
+// Model:
+// - Every action costs a delay in ticks (SCHED_DELAY_NORMAL = 12 for an
+//   average actor; lower is faster)
+// - Player delay from weapon speed, armour weight and STATUS_HASTE
+// - Monster delay from a per-type ROM table (rats fast, zombies slow)
+//
+// Queue:
+// - 32 buckets indexed by next-action tick (mod 32), each a FIFO list
+// - Delays are clamped below 32, so every due tick fits in the ring
+// - Next actor = first non-empty bucket from the current tick, no sorting
+//
+// Parking:
+// - Monsters in MSTATE_SLEEP / MSTATE_IDLE are kept out of the queue
+//   until sched_update_monster() sees them awake again
+// - Despawned monsters drop out the next time they come due
+// - Stunned monsters (MFLAG_STUNNED / MSTATE_STUNNED) lose their action
+//   and are re-queued; clearing the stun is up to the status code
+// - If nothing but stunned monsters comes due within one ring of ticks,
+//   sched_next() gives up and returns SCHED_NONE
+//
+// Performance: ~150 cycles per sched_next() + ~20 cycles per empty bucket
+// Memory: 32 bytes buckets + 21 bytes actor state
+//
+// =============================================================================
+
+#include "tmea_types.h"
+
+enum SchedConstants {
+    SCHED_MAX_ACTORS = MAX_TINY_MONSTERS + 1,   // Player + monster pool
+    SCHED_BUCKETS = 32,                         // Ring size (power of 2)
+    SCHED_MAX_DELAY = SCHED_BUCKETS - 1,        // Longest action delay
+    SCHED_DELAY_NORMAL = 12                     // Average actor
+};
+
+#define SCHED_PLAYER 0
+#define SCHED_NONE 255
+
+// =============================================================================
+// GLOBAL STATE DECLARATIONS
+// =============================================================================
+
+extern unsigned char sched_tick;                    // Current tick (wraps)
+extern unsigned char sched_player_delay;            // Player action delay
+
+// =============================================================================
+// QUEUE FUNCTIONS
+// =============================================================================
+
+/**
+ * @brief Clear queue and schedule the player
+ */
+void sched_init(void);
+
+/**
+ * @brief Get next actor to act and advance time to its tick
+ * @return SCHED_PLAYER, monster actor index (mon_pool[actor - 1]),
+ *         or SCHED_NONE if no actor became ready within SCHED_BUCKETS ticks
+ *
+ * The returned actor is removed from the queue; call sched_done()
+ * after it acted to re-queue it.
+ */
+unsigned char sched_next(void);
+
+/**
+ * @brief Re-queue an actor after its action
+ * @param actor Actor index
+ * @param delay Ticks until it acts again (1..SCHED_MAX_DELAY)
+ */
+void sched_done(unsigned char actor, unsigned char delay);
+
+/**
+ * @brief Queue or park a monster to match its current state
+ * @param mon Monster from mon_pool
+ *
+ * Call after spawning a monster or changing its state
+ * (waking it, putting it to sleep).
+ */
+void sched_update_monster(TinyMon *mon);
+
+// =============================================================================
+// SPEED FUNCTIONS
+// =============================================================================
+
+/**
+ * @brief Compute player action delay
+ * @param weapon_subtype Weapon subtype or ITEM_NONE for bare hands
+ * @param armor_subtype Armor subtype or ITEM_NONE
+ * @param hasted Non-zero if STATUS_HASTE is active (+50% speed)
+ * @return Delay in ticks
+ *
+ * Store the result in sched_player_delay when equipment or haste changes.
+ */
+unsigned char sched_compute_player_delay(unsigned char weapon_subtype,
+                                         unsigned char armor_subtype,
+                                         unsigned char hasted);
+
+/**
+ * @brief Get action delay of an actor
+ * @param actor Actor index
+ * @return Delay in ticks
+ */
+unsigned char sched_actor_delay(unsigned char actor);
+
+#endif // TURN_SCHEDULER_H
@@ -0,0 +1,14 @@
+// Host stand-in for <c64/cia.h> (levelpack native build)
+#ifndef HOST_C64_CIA_H
+#define HOST_C64_CIA_H
+
+struct CIA {
+    unsigned char pra, prb, ddra, ddrb;
+    unsigned short ta, tb;
+    unsigned char todt, tods, todm, todh, sdr, icr, cra, crb;
+};
+
+// Only read for random seeds; levelpack always sets explicit seeds
+static struct CIA cia1, cia2;
+
+#endif
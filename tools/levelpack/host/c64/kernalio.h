@@ -0,0 +1,55 @@
+// Host stand-in for <c64/kernalio.h> (levelpack native build)
+//
+// Reads are served from the files levelpack has built in memory, so the
+// C64 stream loader can be run against them to verify each level.
+#ifndef HOST_C64_KERNALIO_H
+#define HOST_C64_KERNALIO_H
+
+#include <string.h>
+
+// Provided by levelpack.c: file contents for a name ("NAME,S,R" style)
+const unsigned char *host_find_file(const char *name, unsigned short *len);
+
+static char host_name[40];
+static const unsigned char *host_file;
+static unsigned short host_file_len, host_file_pos;
+
+static inline void krnio_setnam(const char *name) {
+    strncpy(host_name, name, sizeof(host_name) - 1);
+}
+
+static inline char krnio_open(char fnum, char device, char channel) {
+    (void)fnum; (void)device; (void)channel;
+    host_file = host_find_file(host_name, &host_file_len);
+    host_file_pos = 0;
+    return host_file != 0;
+}
+
+static inline void krnio_close(char fnum) {
+    (void)fnum;
+    host_file = 0;
+}
+
+static inline short krnio_read(char fnum, char *data, short num) {
+    (void)fnum;
+    short n = 0;
+    while (host_file && n < num && host_file_pos < host_file_len) data[n++] = host_file[host_file_pos++];
+    return n;
+}
+
+static inline short krnio_write(char fnum, const char *data, short num) {
+    (void)fnum; (void)data;
+    return num;
+}
+
+static inline char krnio_save(char device, const char *start, const char *end) {
+    (void)device; (void)start; (void)end;
+    return 0;
+}
+
+static inline char krnio_load(char fnum, char device, char channel) {
+    (void)fnum; (void)device; (void)channel;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,14 @@
+// Host stand-in for <c64/memmap.h> (levelpack native build)
+#ifndef HOST_C64_MEMMAP_H
+#define HOST_C64_MEMMAP_H
+
+#define MMAP_ROM        0x37
+#define MMAP_NO_BASIC   0x36
+#define MMAP_NO_ROM     0x35
+
+static inline char mmap_set(char config) {
+    (void)config;
+    return MMAP_ROM;
+}
+
+#endif
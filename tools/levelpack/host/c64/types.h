@@ -0,0 +1,8 @@
+// Host stand-in for <c64/types.h> (levelpack native build)
+#ifndef HOST_C64_TYPES_H
+#define HOST_C64_TYPES_H
+
+typedef unsigned char byte;
+typedef unsigned short word;
+
+#endif
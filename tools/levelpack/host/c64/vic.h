@@ -0,0 +1,14 @@
+// Host stand-in for <c64/vic.h> (levelpack native build)
+#ifndef HOST_C64_VIC_H
+#define HOST_C64_VIC_H
+
+struct VIC {
+    unsigned char spr_pos[16];
+    unsigned char spr_msbx, ctrl1, raster, lpx, lpy, spr_enable, ctrl2, spr_expand_y;
+    unsigned char memptr, intr_ctrl, intr_enable, spr_priority, spr_multi;
+    unsigned char spr_expand_x, spr_sprcol, spr_backcol, color_border, color_back;
+};
+
+static struct VIC vic;
+
+#endif
@@ -0,0 +1,4 @@
+// Host stand-in for <conio.h> (levelpack native build, nothing is printed)
+#ifndef HOST_CONIO_H
+#define HOST_CONIO_H
+#endif
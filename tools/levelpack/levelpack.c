@@ -0,0 +1,518 @@
+// =============================================================================
+// LEVELPACK - Host Tool: Pre-Generate Quest Levels into a .d64 Level Pack
+// =============================================================================
+//
+// Native build of the C64 mapgen sources (same code, 16-bit int) that
+// generates every level of a Quest, writes it in level pack format
+// (main/src/mapgen/level_pack.h) and stores the pack on a new .d64.
+//
+// Each level is verified before it is written: it is streamed back
+// through the C64 loader (level_pack_load) from the in-memory file and
+// compared with the generated level.
+//
+// Usage:
+//   levelpack <out.d64> <NAME> <quest-seed> [-m size] [-n levels]
+//   levelpack <out.d64> <NAME> -s seed,seed,... [-m size]
+//   levelpack -t <seeds> [-m size]
+//
+//   quest-seed   Level seeds follow the mapgen LCG: s = s * 75 + 74
+//                (dungeon_set_next_seed, as mapgen_generate_dungeon_set)
+//   -s           Curated seed list, one level per seed
+//   -m 0|1|2     Map size preset for all levels (default: SMALL for
+//                levels 0-3, MEDIUM 4-7, LARGE 8-11); 3 = HUGE when
+//                built with -DMAPGEN_LARGE_MAPS
+//   -n 1-12      Level count for a Quest seed (default 12)
+//
+// Level depth is the level number; hidden rooms, niches and deception
+// use the MEDIUM preset.
+//
+// -t writes no pack: it generates seeds 1..<seeds> per map size (or the
+// -m one) and prints the MapgenStats retry and rejection counters summed
+// over all seeds, with the average per map.
+//
+// =============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+// Oscar64 keywords, and the 16-bit int of the C64 target: generation
+// must produce the same levels as on the C64
+#define __zeropage
+#define __assume(x)
+#define __striped
+#define __asm                           // Only { sei } / { cli } blocks reach
+#define sei                             // the host build: IRQ masking is a no-op
+#define cli
+#define int short
+#define LEVEL_PACK_WRITER
+#ifdef MAPGEN_LARGE_MAPS
+static unsigned char host_map_high[0xC00];  // Map chunks the C64 keeps at $C000
+#define MAP_HIGH_BASE host_map_high
+#endif
+#define main c64_main
+#include "../../main/src/main.c"
+#undef main
+#undef int
+#undef sei
+#undef cli
+
+// =============================================================================
+// D64 IMAGE
+// =============================================================================
+
+enum D64Constants {
+    D64_TRACKS = 35,
+    D64_SECTORS = 683,
+    D64_DIR_TRACK = 18,
+    D64_INTERLEAVE = 10,                // Data sectors, as the 1541 DOS
+    D64_DIR_INTERLEAVE = 3,
+    D64_MAX_FILES = 16
+};
+
+static unsigned char d64[D64_SECTORS * 256];
+static unsigned char d64_used[D64_TRACKS + 1][21];
+static unsigned char d64_track = D64_DIR_TRACK - 1, d64_sector;
+static unsigned char d64_dir_sector = 1;
+static int d64_dir_entries;
+
+static int d64_sectors_on(int track) {
+    return track <= 17 ? 21 : track <= 24 ? 19 : track <= 30 ? 18 : 17;
+}
+
+static unsigned char *d64_block(int track, int sector) {
+    int index = 0;
+    for (int t = 1; t < track; t++) index += d64_sectors_on(t);
+    return d64 + (index + sector) * 256;
+}
+
+static void d64_mark(int track, int sector) {
+    d64_used[track][sector] = 1;
+}
+
+// Next free data sector: tracks 17 down to 1, then 19 up to 35
+static int d64_alloc(unsigned char *track, unsigned char *sector) {
+    while (d64_track >= 1 && d64_track <= D64_TRACKS) {
+        int n = d64_sectors_on(d64_track);
+        for (int i = 0; i < n; i++) {
+            int s = (d64_sector + i) % n;
+            if (!d64_used[d64_track][s]) {
+                d64_mark(d64_track, s);
+                *track = d64_track;
+                *sector = (unsigned char)s;
+                d64_sector = (unsigned char)((s + D64_INTERLEAVE) % n);
+                return 1;
+            }
+        }
+        d64_track = (d64_track < D64_DIR_TRACK) ? d64_track - 1 : d64_track + 1;
+        if (d64_track == 0) d64_track = D64_DIR_TRACK + 1;
+        d64_sector = 0;
+    }
+    return 0;
+}
+
+static void d64_pad_name(unsigned char *dst, const char *name) {
+    memset(dst, 0xA0, 16);
+    for (int i = 0; i < 16 && name[i]; i++) dst[i] = (unsigned char)name[i];
+}
+
+static void d64_format(const char *disk_name) {
+    memset(d64, 0, sizeof(d64));
+    memset(d64_used, 0, sizeof(d64_used));
+    d64_mark(D64_DIR_TRACK, 0);
+    d64_mark(D64_DIR_TRACK, 1);
+
+    unsigned char *bam = d64_block(D64_DIR_TRACK, 0);
+    bam[0] = D64_DIR_TRACK;
+    bam[1] = 1;
+    bam[2] = 0x41;                      // 'A' - 1541 format
+    d64_pad_name(bam + 0x90, disk_name);
+    memcpy(bam + 0xA0, "\xA0\xA0" "LP" "\xA0" "2A" "\xA0\xA0\xA0\xA0", 11);
+
+    unsigned char *dir = d64_block(D64_DIR_TRACK, 1);
+    dir[1] = 0xFF;
+}
+
+// Write a SEQ file; returns 0 if the disk is full
+static int d64_write_file(const char *name, const unsigned char *data, int len) {
+    unsigned char track, sector, first_t = 0, first_s = 0;
+    unsigned char *prev = NULL;
+    int blocks = 0, pos = 0;
+
+    do {
+        if (!d64_alloc(&track, &sector)) return 0;
+        if (prev) {
+            prev[0] = track;
+            prev[1] = sector;
+        } else {
+            first_t = track;
+            first_s = sector;
+        }
+        unsigned char *block = d64_block(track, sector);
+        int n = len - pos > 254 ? 254 : len - pos;
+        memcpy(block + 2, data + pos, n);
+        block[0] = 0;
+        block[1] = (unsigned char)(n + 1);  // Last byte used
+        pos += n;
+        prev = block;
+        blocks++;
+    } while (pos < len);
+
+    // Directory entry (8 per sector, chained on track 18)
+    if (d64_dir_entries && d64_dir_entries % 8 == 0) {
+        unsigned char next = d64_dir_sector + D64_DIR_INTERLEAVE;
+        unsigned char *old = d64_block(D64_DIR_TRACK, d64_dir_sector);
+        old[0] = D64_DIR_TRACK;
+        old[1] = next;
+        d64_dir_sector = next;
+        d64_mark(D64_DIR_TRACK, next);
+        d64_block(D64_DIR_TRACK, next)[1] = 0xFF;
+    }
+    unsigned char *entry = d64_block(D64_DIR_TRACK, d64_dir_sector) + (d64_dir_entries % 8) * 32;
+    entry[2] = 0x81;                    // SEQ, closed
+    entry[3] = first_t;
+    entry[4] = first_s;
+    d64_pad_name(entry + 5, name);
+    entry[30] = (unsigned char)(blocks & 0xFF);
+    entry[31] = (unsigned char)(blocks >> 8);
+    d64_dir_entries++;
+    return 1;
+}
+
+static void d64_finish(void) {
+    unsigned char *bam = d64_block(D64_DIR_TRACK, 0);
+    for (int t = 1; t <= D64_TRACKS; t++) {
+        unsigned char *e = bam + 4 * t;
+        unsigned char free_count = 0;
+        e[1] = e[2] = e[3] = 0;
+        for (int s = 0; s < d64_sectors_on(t); s++) {
+            if (!d64_used[t][s]) {
+                free_count++;
+                e[1 + s / 8] |= (unsigned char)(1 << (s % 8));
+            }
+        }
+        e[0] = free_count;
+    }
+}
+
+// =============================================================================
+// PACK FILES (also served to the host kernalio for verification)
+// =============================================================================
+
+typedef struct {
+    char name[20];
+    unsigned char *data;
+    unsigned short len;
+} PackFile;
+
+static PackFile pack_files[LEVEL_PACK_MAX_LEVELS + 1];
+static int pack_file_count;
+
+// Level file and level check buffers, sized in main() from the largest
+// possible level (level_pack_max_data)
+static unsigned char *level_data;
+static unsigned long level_data_size;
+static unsigned short level_len;
+
+static void level_sink(unsigned char value) {
+    if (level_len < level_data_size) level_data[level_len] = value;
+    level_len++;
+}
+
+static PackFile *add_file(const char *name, const unsigned char *data, unsigned short len) {
+    PackFile *file = &pack_files[pack_file_count++];
+    snprintf(file->name, sizeof(file->name), "%s", name);
+    file->data = malloc(len ? len : 1);
+    memcpy(file->data, data, len);
+    file->len = len;
+    return file;
+}
+
+const unsigned char *host_find_file(const char *name, unsigned short *len) {
+    size_t n = strcspn(name, ",");
+    for (int i = 0; i < pack_file_count; i++) {
+        if (strlen(pack_files[i].name) == n && !strncmp(pack_files[i].name, name, n)) {
+            *len = pack_files[i].len;
+            return pack_files[i].data;
+        }
+    }
+    return NULL;
+}
+
+// =============================================================================
+// LEVEL CHECK
+// =============================================================================
+
+enum {
+    CHECK_OBJ_RECORD = 5,               // pool index x y type data
+    CHECK_MON_RECORD = 7                // pool index x y type hp flags state
+};
+
+static unsigned char *check_image[2];
+static unsigned long check_size;
+
+// Level data blocks plus entities, as bytes; -1 if they do not fit
+static long capture(unsigned char *out) {
+    CacheBlock block;
+    unsigned long n = 0;
+    for (unsigned char i = 0; level_pack_block(i, &block); i++) {
+        if (n + block.size > check_size) return -1;
+        memcpy(out + n, block.ptr, block.size);
+        n += block.size;
+    }
+    for (TinyObj *obj = obj_active_list; obj; obj = obj->next) {
+        if (n + CHECK_OBJ_RECORD > check_size) return -1;
+        out[n++] = (unsigned char)(obj - obj_pool);
+        out[n++] = obj->x;
+        out[n++] = obj->y;
+        out[n++] = obj->type;
+        out[n++] = obj->data;
+    }
+    for (TinyMon *mon = mon_active_list; mon; mon = mon->next) {
+        if (n + CHECK_MON_RECORD > check_size) return -1;
+        out[n++] = (unsigned char)(mon - mon_pool);
+        out[n++] = mon->x;
+        out[n++] = mon->y;
+        out[n++] = mon->type;
+        out[n++] = mon->hp;
+        out[n++] = mon->flags;
+        out[n++] = mon->state;
+    }
+    return n;
+}
+
+// =============================================================================
+// GENERATION STATISTICS (-t)
+// =============================================================================
+
+enum { STAT_FIELDS = 16 };
+
+static const char *const stat_names[STAT_FIELDS] = {
+    "place attempts", "cells exhausted", "pin fallbacks",
+    "mst fallbacks", "connect failures", "rooms unjoined",
+    "hidden rejects",
+    "niche attempts", "niche rejects",
+    "decoy attempts", "decoy fallbacks", "decoy path rejects", "decoy adjacent rejects",
+    "passage candidates", "passage rejects",
+    "span overflows"
+};
+
+static void stats_add(unsigned long *sum, const MapgenStats *s) {
+    const unsigned long v[STAT_FIELDS] = {
+        s->place_attempts, s->cells_exhausted, s->pin_fallbacks,
+        s->mst_fallbacks, s->connect_failures, s->rooms_unjoined,
+        s->hidden_rejects,
+        s->niche_attempts, s->niche_rejects,
+        s->decoy_attempts, s->decoy_fallbacks, s->decoy_path_rejects, s->decoy_adjacent_rejects,
+        s->passage_candidates, s->passage_rejects,
+        s->span_overflows
+    };
+    for (int i = 0; i < STAT_FIELDS; i++) sum[i] += v[i];
+}
+
+static int run_stats(int seeds, int fixed_size) {
+    init_tmea_system();
+
+    for (int size = 0; size <= MAP_SIZE_MAX; size++) {
+        if (fixed_size >= 0 && size != fixed_size) continue;
+
+        unsigned long sum[STAT_FIELDS] = { 0 };
+        unsigned long rooms = 0;
+        int failed = 0;
+
+        for (int seed = 1; seed <= seeds; seed++) {
+            MapgenStats stats;
+            mapgen_init((unsigned short)seed);
+            if (mapgen_generate_with_params((unsigned char)size, 1, 1, 1)) failed++;
+            mapgen_get_stats(&stats);
+            stats_add(sum, &stats);
+            rooms += room_count;
+        }
+
+        printf("size %d: %d seeds, %d failed, %.1f rooms per map\n", size, seeds, failed,
+               (double)rooms / seeds);
+        for (int i = 0; i < STAT_FIELDS; i++) {
+            printf("  %-24s %8lu  %7.2f per map\n", stat_names[i], sum[i], (double)sum[i] / seeds);
+        }
+    }
+    return 0;
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+static void usage(void) {
+    fprintf(stderr,
+            "usage: levelpack <out.d64> <NAME> <quest-seed> [-m size] [-n levels]\n"
+            "       levelpack <out.d64> <NAME> -s seed,seed,... [-m size]\n"
+            "       levelpack -t <seeds> [-m size]\n");
+    exit(1);
+}
+
+int main(int argc, char **argv) {
+    unsigned short seeds[LEVEL_PACK_MAX_LEVELS];
+    int count = LEVEL_PACK_MAX_LEVELS, fixed_size = -1, curated = 0;
+
+    if (argc >= 3 && !strcmp(argv[1], "-t")) {
+        int seeds = atoi(argv[2]);
+        if (seeds < 1 || seeds > 65535) usage();
+        if (argc == 5 && !strcmp(argv[3], "-m")) {
+            fixed_size = atoi(argv[4]);
+            if (fixed_size < 0 || fixed_size > MAP_SIZE_MAX) usage();
+        } else if (argc != 3) {
+            usage();
+        }
+        return run_stats(seeds, fixed_size);
+    }
+
+    if (argc < 4) usage();
+    const char *out_path = argv[1];
+    const char *name = argv[2];
+    if (strlen(name) > LEVEL_PACK_NAME_MAX) {
+        fprintf(stderr, "levelpack: name longer than %d characters\n", LEVEL_PACK_NAME_MAX);
+        return 1;
+    }
+
+    for (int i = 3; i < argc; i++) {
+        if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+            char *p = argv[++i];
+            count = 0;
+            while (*p && count < LEVEL_PACK_MAX_LEVELS) {
+                seeds[count++] = (unsigned short)strtoul(p, &p, 0);
+                if (*p == ',') p++;
+            }
+            curated = 1;
+        } else if (!strcmp(argv[i], "-m") && i + 1 < argc) {
+            fixed_size = atoi(argv[++i]);
+            if (fixed_size < 0 || fixed_size > MAP_SIZE_MAX) usage();
+        } else if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+            count = atoi(argv[++i]);
+            if (count < 1 || count > LEVEL_PACK_MAX_LEVELS) usage();
+        } else if (i == 3) {
+            seeds[0] = (unsigned short)strtoul(argv[i], NULL, 0);
+        } else {
+            usage();
+        }
+    }
+    if (!curated) {
+        unsigned short s = seeds[0];
+        for (int i = 0; i < LEVEL_PACK_MAX_LEVELS; i++) {
+            s = seeds[i] = dungeon_set_next_seed(s);
+        }
+    }
+
+    init_tmea_system();
+
+    // Largest level: all blocks full, worst case LZ output (1 extra byte
+    // per 128 and per block), every object and monster
+    unsigned long max_data = level_pack_max_data();
+#ifdef MAPGEN_LARGE_MAPS
+    unsigned long max_blocks = PACK_FIXED_BLOCKS + MAP_CHUNKS + PACK_VARIABLE_BLOCKS;
+#else
+    unsigned long max_blocks = PACK_FIXED_BLOCKS + 1 + PACK_VARIABLE_BLOCKS;
+#endif
+    level_data_size = max_data + max_data / 128 + max_blocks + 2
+                    + MAX_TINY_OBJECTS * LEVEL_PACK_OBJ_RECORD + MAX_TINY_MONSTERS * LEVEL_PACK_MON_RECORD;
+    check_size = max_data + MAX_TINY_OBJECTS * CHECK_OBJ_RECORD + MAX_TINY_MONSTERS * CHECK_MON_RECORD;
+    level_data = malloc(level_data_size);
+    check_image[0] = malloc(check_size);
+    check_image[1] = malloc(check_size);
+    if (!level_data || !check_image[0] || !check_image[1]) {
+        fprintf(stderr, "levelpack: out of memory\n");
+        return 1;
+    }
+
+    // Directory first: level_pack_regenerate() works from it
+    level_pack_count = (unsigned char)count;
+    for (int i = 0; i < count; i++) {
+        int size = fixed_size >= 0 ? fixed_size : dungeon_set_map_size((unsigned char)i);
+        level_pack_dir[i].seed_lo = (unsigned char)(seeds[i] & 0xFF);
+        level_pack_dir[i].seed_hi = (unsigned char)(seeds[i] >> 8);
+        level_pack_dir[i].depth = (unsigned char)i;
+        level_pack_dir[i].presets = LEVEL_PACK_PRESETS(size, 1, 1, 1);
+    }
+
+    d64_format(name);
+    unsigned int total = 0;
+
+    for (int i = 0; i < count; i++) {
+        if (!level_pack_regenerate((unsigned char)i)) {
+            fprintf(stderr, "levelpack: level %d (seed %u) failed to generate\n", i, seeds[i]);
+            return 1;
+        }
+
+        level_len = 0;
+        level_pack_write_level(level_sink);
+        if (level_len > level_data_size) {
+            fprintf(stderr, "levelpack: level %d too large\n", i);
+            return 1;
+        }
+
+        char file_name[20];
+        snprintf(file_name, sizeof(file_name), "%s%02d", name, i);
+        add_file(file_name, level_data, level_len);
+        level_pack_dir[i].size_lo = (unsigned char)(level_len & 0xFF);
+        level_pack_dir[i].size_hi = (unsigned char)(level_len >> 8);
+        total += level_len;
+    }
+
+    // Index file
+    unsigned char index[5 + LEVEL_PACK_MAX_LEVELS * sizeof(LevelPackEntry)];
+    index[0] = LEVEL_PACK_MAGIC_0;
+    index[1] = LEVEL_PACK_MAGIC_1;
+    index[2] = LEVEL_PACK_VERSION;
+    index[3] = LEVEL_PACK_BUILD;
+    index[4] = (unsigned char)count;
+    memcpy(index + 5, level_pack_dir, count * sizeof(LevelPackEntry));
+    add_file(name, index, (unsigned short)(5 + count * sizeof(LevelPackEntry)));
+
+    // Read everything back through the C64 loader
+    if (!level_pack_open(name) || level_pack_count != count) {
+        fprintf(stderr, "levelpack: index does not read back\n");
+        return 1;
+    }
+    for (int i = 0; i < count; i++) {
+        level_pack_regenerate((unsigned char)i);
+        long raw = capture(check_image[0]);
+        unsigned char rooms = room_count;
+        if (raw < 0) {
+            fprintf(stderr, "levelpack: level %d does not fit the check buffer\n", i);
+            return 1;
+        }
+
+        if (!level_pack_load((unsigned char)i) || capture(check_image[1]) != raw ||
+            memcmp(check_image[0], check_image[1], raw)) {
+            fprintf(stderr, "levelpack: level %d does not load back identically\n", i);
+            return 1;
+        }
+        printf("level %2d  seed %5u  size %d  rooms %2d  %5ld -> %4u bytes\n",
+               i, seeds[i], LEVEL_PACK_PRESET(level_pack_dir[i].presets, 0), rooms,
+               raw, pack_files[i].len);
+    }
+
+    // Index first in the directory
+    if (!d64_write_file(pack_files[pack_file_count - 1].name, pack_files[pack_file_count - 1].data,
+                        pack_files[pack_file_count - 1].len)) {
+        fprintf(stderr, "levelpack: disk full\n");
+        return 1;
+    }
+    for (int i = 0; i < pack_file_count - 1; i++) {
+        if (!d64_write_file(pack_files[i].name, pack_files[i].data, pack_files[i].len)) {
+            fprintf(stderr, "levelpack: disk full\n");
+            return 1;
+        }
+    }
+    d64_finish();
+
+    FILE *f = fopen(out_path, "wb");
+    if (!f || fwrite(d64, 1, sizeof(d64), f) != sizeof(d64)) {
+        fprintf(stderr, "levelpack: cannot write %s\n", out_path);
+        return 1;
+    }
+    fclose(f);
+
+    printf("%d levels, %u bytes -> %s\n", count, total, out_path);
+    return 0;
+}
@@ -0,0 +1,93 @@
+// =============================================================================
+// OVLPACK - Host Tool: Pack an Overlay for the Streaming Overlay Loader
+// =============================================================================
+//
+// Compresses a PRG file (load address + data, e.g. the MAPGEN overlay)
+// with the C64 lz_codec into overlay_loader format
+// (main/src/mapgen/overlay_loader.h). The result is checked by decoding
+// it again before it is written.
+//
+// Usage:
+//   ovlpack <in.prg> <out.lz>
+//
+// Put the output on the game disk as a PRG file, e.g. with VICE:
+//   c1541 game.d64 -write out.lz mapgen.lz
+//
+// =============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../main/src/mapgen/overlay_loader.h"
+#include "../../main/src/mapgen/lz_codec.c"
+
+enum OvlpackConstants {
+    OVLPACK_MAX = 0xD000                // Loader accepts nothing larger
+};
+
+static unsigned char in_data[OVLPACK_MAX + 2];
+static unsigned char out_data[OVERLAY_HEADER_SIZE + OVLPACK_MAX + OVLPACK_MAX / 128 + 1];
+static unsigned char check_data[OVLPACK_MAX];
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: ovlpack <in.prg> <out.lz>\n");
+        return 1;
+    }
+
+    FILE *f = fopen(argv[1], "rb");
+    if (!f) {
+        fprintf(stderr, "ovlpack: cannot open %s\n", argv[1]);
+        return 1;
+    }
+    size_t len = fread(in_data, 1, sizeof(in_data), f);
+    int too_large = fgetc(f) != EOF;
+    fclose(f);
+    if (len < 3 || too_large) {
+        fprintf(stderr, "ovlpack: %s is empty or larger than the loader accepts\n", argv[1]);
+        return 1;
+    }
+
+    unsigned int addr = in_data[0] | (in_data[1] << 8);
+    unsigned int size = (unsigned int)len - 2;
+    unsigned int end = addr + size;
+    if (end > 0xFFFA || (end > 0xD000 && addr < 0xE000)) {
+        fprintf(stderr, "ovlpack: $%04X-$%04X is not a loadable area\n", addr, end - 1);
+        return 1;
+    }
+
+    out_data[0] = OVERLAY_MAGIC_0;
+    out_data[1] = OVERLAY_MAGIC_1;
+    out_data[2] = OVERLAY_VERSION;
+    out_data[3] = addr & 0xFF;
+    out_data[4] = addr >> 8;
+    out_data[5] = size & 0xFF;
+    out_data[6] = size >> 8;
+
+    unsigned int packed = lz_compress(in_data + 2, size, out_data + OVERLAY_HEADER_SIZE,
+                                      sizeof(out_data) - OVERLAY_HEADER_SIZE);
+    if (!packed) {
+        fprintf(stderr, "ovlpack: compression failed\n");
+        return 1;
+    }
+
+    // Same decoder as the C64 side
+    lz_decompress(out_data + OVERLAY_HEADER_SIZE, check_data, size);
+    if (memcmp(check_data, in_data + 2, size)) {
+        fprintf(stderr, "ovlpack: verify failed\n");
+        return 1;
+    }
+
+    f = fopen(argv[2], "wb");
+    if (!f || fwrite(out_data, 1, OVERLAY_HEADER_SIZE + packed, f) != OVERLAY_HEADER_SIZE + packed) {
+        fprintf(stderr, "ovlpack: cannot write %s\n", argv[2]);
+        return 1;
+    }
+    fclose(f);
+
+    printf("$%04X-$%04X  %u -> %u bytes (%u%%), park %s\n", addr, end - 1, size,
+           OVERLAY_HEADER_SIZE + packed, (OVERLAY_HEADER_SIZE + packed) * 100 / size,
+           packed <= OVERLAY_PARK_SIZE ? "fits" : "too large");
+    return 0;
+}